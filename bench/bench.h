@@ -0,0 +1,111 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define ACPPJSON_BENCH_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define ACPPJSON_BENCH_RDTSC 1
+#endif
+
+namespace libacpp::json::bench {
+
+// Time stamp counter on x86 (reference cycles), nanoseconds elsewhere.
+inline uint64_t ticks() {
+#if defined(ACPPJSON_BENCH_RDTSC)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline const char* tick_unit() {
+#if defined(ACPPJSON_BENCH_RDTSC)
+    return "cycle";
+#else
+    return "ns";
+#endif
+}
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+struct Measurement {
+    size_t bytes = 0;       // bytes processed by one iteration
+    size_t iterations = 0;
+    double seconds = 0;     // fastest iteration
+    uint64_t ticks = 0;     // fastest iteration
+
+    double gb_per_s() const { return seconds > 0 ? bytes / seconds / 1e9 : 0; }
+    double mb_per_s() const { return seconds > 0 ? bytes / seconds / 1e6 : 0; }
+    double bytes_per_tick() const { return ticks > 0 ? double(bytes) / ticks : 0; }
+};
+
+// Runs fn repeatedly for at least min_seconds (and min_iterations runs) and
+// keeps the fastest run.
+template <typename F>
+Measurement measure(size_t bytes, F&& fn, double min_seconds = 0.25, size_t min_iterations = 5) {
+    using clock = std::chrono::steady_clock;
+    Measurement m;
+    m.bytes = bytes;
+    fn(); // warm up caches and lazily selected kernels
+    auto start = clock::now();
+    while (m.iterations < min_iterations
+        || std::chrono::duration<double>(clock::now() - start).count() < min_seconds) {
+        auto t0 = clock::now();
+        uint64_t c0 = ticks();
+        fn();
+        uint64_t c1 = ticks();
+        double s = std::chrono::duration<double>(clock::now() - t0).count();
+        if (m.iterations == 0 || s < m.seconds) {
+            m.seconds = s;
+            m.ticks = c1 - c0;
+        }
+        ++m.iterations;
+    }
+    return m;
+}
+
+inline void report(const std::string& name, const Measurement& m) {
+    std::printf("%-48s %10zu B %8.3f GB/s %8.3f B/%s\n",
+        name.c_str(), m.bytes, m.gb_per_s(), m.bytes_per_tick(), tick_unit());
+}
+
+using BenchFn = void (*)();
+
+inline std::vector<std::pair<std::string, BenchFn>>& registry() {
+    static std::vector<std::pair<std::string, BenchFn>> r;
+    return r;
+}
+
+struct Registration {
+    Registration(const char* name, BenchFn fn) { registry().emplace_back(name, fn); }
+};
+
+#define ACPPJSON_BENCH(name) \
+    static void name(); \
+    static ::libacpp::json::bench::Registration name##_registration(#name, name); \
+    static void name()
+
+} // namespace libacpp::json::bench
@@ -0,0 +1,116 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/parser.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "counters.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+// Parses the items of doc, each followed by a one byte separator, with a
+// single parser reset between items. The input is handed over in chunk byte
+// pieces cut at fixed offsets of the document (0: all at once), as a
+// stream would deliver it. Returns the number of items parsed.
+template <typename Parser>
+size_t parse_items(Parser& parser, const std::string& doc, size_t chunk) {
+    const char* begin = doc.data();
+    const char* p = begin;
+    const char* end = begin + doc.size();
+    size_t n = 0;
+    while (p != end) {
+        if constexpr (requires { parser.reset(); })
+            parser.reset();
+        ParseResult r = ParseResult::partial;
+        while (p != end && r == ParseResult::partial) {
+            const char* chunk_end = end;
+            if (chunk != 0 && static_cast<size_t>(end - p) > chunk)
+                chunk_end = begin + ((p - begin) / chunk + 1) * chunk;
+            r = parser.parse(p, chunk_end);
+        }
+        if (r != ParseResult::ok)
+            break;
+        ++n;
+        if (p != end)
+            ++p; // separator
+    }
+    return n;
+}
+
+void report(const std::string& name, const bench::CountedMeasurement& m, size_t items) {
+    const double bytes = static_cast<double>(m.bytes);
+    if (m.counted) {
+        const bench::CounterValues& c = m.counters;
+        std::printf("%-28s %8.3f GB/s %7.2f cycles/B %7.2f instr/B %5.2f IPC %8.2f br-miss/KB %6.3f br-miss/item\n",
+            name.c_str(), m.gb_per_s(), c.cycles / bytes, c.instructions / bytes,
+            c.cycles ? double(c.instructions) / c.cycles : 0.0, c.branch_misses * 1024 / bytes,
+            items ? double(c.branch_misses) / items : 0.0);
+    } else {
+        std::printf("%-28s %8.3f GB/s %7.2f %s/B (no hardware counters)\n",
+            name.c_str(), m.gb_per_s(), m.ticks / bytes, bench::tick_unit());
+    }
+}
+
+template <typename Parser>
+void run(const std::string& component, const std::string& doc, Parser& parser) {
+    for (size_t chunk: {size_t{0}, size_t{1}, size_t{16}, size_t{4096}}) {
+        size_t items = 0;
+        auto m = bench::measure_counted(doc.size(), [&]() {
+            items = parse_items(parser, doc, chunk);
+            bench::do_not_optimize(items);
+        });
+        report(component + "/" + (chunk == 0 ? std::string("whole") : std::to_string(chunk)), m, items);
+    }
+}
+
+// Separated items drawn from the samples until doc holds about target_bytes.
+std::string items(std::initializer_list<const char*> samples, char separator, size_t target_bytes = 1 << 20) {
+    bench::corpus::Random rnd(5);
+    std::vector<const char*> v(samples);
+    std::string out;
+    while (out.size() < target_bytes) {
+        out += v[rnd.uniform(v.size())];
+        out.push_back(separator);
+    }
+    return out;
+}
+
+} // namespace
+
+// Each leaf parser alone, per chunk size: where the time of the switch
+// driven loops of parser.inl goes, and how well they predict.
+ACPPJSON_BENCH(components) {
+    if (!bench::perf_counters().available())
+        std::printf("perf_event_open unavailable: reporting %s per byte only\n", bench::tick_unit());
+    bench::NullConsumer consumer;
+
+    StringParser<bench::NullConsumer, false> string_parser(consumer);
+    run("StringParser", items({R"("a")", R"("hello")", R"("some longer text value")",
+        R"("tab\tand \"quote\"")", R"("café")"}, ' '), string_parser);
+
+    NumberParser<bench::NullConsumer> number_parser(consumer);
+    run("NumberParser", items({"0", "7", "12345", "-17", "3.25", "-0.000123", "6.02e23",
+        "1234567890123", "2.718281828459045"}, ' '), number_parser);
+
+    TrueParser true_parser;
+    run("LiteralParser", items({"true"}, ' '), true_parser);
+
+    WhiteSpaceParser ws_parser;
+    run("WhiteSpaceParser", items({"", " ", "\n    ", "\n        ", "\n            ", " \t"}, 'x'), ws_parser);
+
+    KeyValueParser<bench::NullConsumer> kv_parser(consumer);
+    run("KeyValueParser", items({R"("id":12345)", R"("name": "hello")", R"("active":true)",
+        R"( "score" : 3.25)", R"("parent":null)"}, ','), kv_parser);
+}
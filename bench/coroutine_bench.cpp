@@ -0,0 +1,106 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libacpp-json/coroutine.h>
+#include <libacpp-json/document_stream.h>
+#include <libacpp-json/parser.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+Task reader(AsyncParser<bench::NullConsumer>& parser, size_t& documents) {
+    ParseResult r;
+    while ((r = co_await parser.document()) == ParseResult::ok)
+        ++documents;
+}
+
+Task producer(AsyncParser<bench::NullConsumer>& parser, std::string_view input, size_t chunk) {
+    for (size_t i = 0; i < input.size(); i += chunk)
+        co_await parser.feed(input.substr(i, chunk));
+    co_await parser.close();
+}
+
+std::vector<std::string_view> chunks(std::string_view input, size_t chunk) {
+    std::vector<std::string_view> out;
+    for (size_t i = 0; i < input.size(); i += chunk)
+        out.push_back(input.substr(i, chunk));
+    return out;
+}
+
+} // namespace
+
+// Concatenated documents in 4 and 64 KiB chunks: the partial-result loop of
+// a DocumentStream against a reader coroutine resumed by an AsyncParser at
+// every document, fed by a producer coroutine.
+ACPPJSON_BENCH(coroutine) {
+    const std::string lines = bench::corpus::json_lines(1 << 22);
+    for (size_t chunk: {4 << 10, 64 << 10}) {
+        const std::string size = std::to_string(chunk >> 10) + "KiB";
+        bench::report("coroutine/loop/" + size, bench::measure(lines.size(), [&]() {
+            bench::NullConsumer consumer;
+            DocumentStream<bench::NullConsumer> stream(consumer, Framing::concatenated);
+            const char* p = lines.data();
+            const char* end = p + lines.size();
+            while (p != end)
+                stream.parse(p, std::min(p + chunk, end));
+            stream.finish();
+            bench::do_not_optimize(stream.documents());
+        }));
+        bench::report("coroutine/async/" + size, bench::measure(lines.size(), [&]() {
+            bench::NullConsumer consumer;
+            AsyncParser<bench::NullConsumer> parser(consumer);
+            size_t documents = 0;
+            reader(parser, documents);
+            producer(parser, lines, chunk);
+            bench::do_not_optimize(documents);
+        }));
+    }
+}
+
+// One document in 64 KiB chunks: the plain loop into a consumer that drops
+// everything, against pulling its events from json_events().
+ACPPJSON_BENCH(coroutine_events) {
+    const std::string doc = bench::corpus::mixed(1 << 22);
+    const std::vector<std::string_view> input = chunks(doc, 64 << 10);
+    bench::report("coroutine/events/loop", bench::measure(doc.size(), [&]() {
+        bench::NullConsumer consumer;
+        ValueParser<bench::NullConsumer> parser(consumer);
+        ParseResult r = ParseResult::partial;
+        for (std::string_view chunk: input) {
+            const char* p = chunk.data();
+            r = parser.parse(p, p + chunk.size());
+        }
+        bench::do_not_optimize(r);
+    }));
+    bench::report("coroutine/events/generator", bench::measure(doc.size(), [&]() {
+        size_t events = 0;
+        for (const JsonEvent& e: json_events(input))
+            events += e.text.size();
+        bench::do_not_optimize(events);
+    }));
+}
@@ -0,0 +1,282 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// Deterministic synthetic JSON documents for the benchmarks. The same seed
+// always yields the same bytes, so numbers are comparable across runs.
+namespace libacpp::json::bench::corpus {
+
+class Random {
+public:
+    explicit Random(uint64_t seed): state_(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+    uint64_t next() {
+        // xorshift64*
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 0x2545F4914F6CDD1Dull;
+    }
+
+    uint64_t uniform(uint64_t n) { return next() % n; }
+
+private:
+    uint64_t state_;
+};
+
+inline void append_word(std::string& out, Random& rnd, size_t min_len, size_t max_len) {
+    size_t len = min_len + rnd.uniform(max_len - min_len + 1);
+    for (size_t i = 0; i < len; ++i)
+        out.push_back(static_cast<char>('a' + rnd.uniform(26)));
+}
+
+inline void append_text(std::string& out, Random& rnd, size_t words) {
+    for (size_t i = 0; i < words; ++i) {
+        if (i != 0)
+            out.push_back(' ');
+        append_word(out, rnd, 1, 9);
+    }
+}
+
+// Minified array of records mixing strings, integers, decimals, literals,
+// nested objects and arrays.
+inline std::string mixed(size_t target_bytes, uint64_t seed = 1) {
+    Random rnd(seed);
+    std::string out = "[";
+    size_t id = 0;
+    while (out.size() < target_bytes) {
+        if (id != 0)
+            out.push_back(',');
+        out += R"({"id":)" + std::to_string(id++);
+        out += R"(,"name":")";
+        append_word(out, rnd, 4, 12);
+        out += R"(","text":")";
+        append_text(out, rnd, 4 + rnd.uniform(12));
+        out += R"(","score":)" + std::to_string(rnd.uniform(100000)) + "." + std::to_string(rnd.uniform(1000));
+        out += R"(,"active":)";
+        out += rnd.uniform(2) ? "true" : "false";
+        out += R"(,"parent":null,"tags":[)";
+        for (size_t i = 0, n = rnd.uniform(4); i < n; ++i) {
+            if (i != 0)
+                out.push_back(',');
+            out.push_back('"');
+            append_word(out, rnd, 3, 8);
+            out.push_back('"');
+        }
+        out += R"(],"geo":{"lat":)" + std::to_string(rnd.uniform(180)) + "." + std::to_string(rnd.uniform(1000000));
+        out += R"(,"lon":)" + std::to_string(rnd.uniform(360)) + "." + std::to_string(rnd.uniform(1000000)) + "}}";
+    }
+    out += "]";
+    return out;
+}
+
+// Like twitter.json: a search result of status objects, mostly strings
+// (free text with escapes and non ASCII UTF-8, URLs, dates) and a few
+// integers, literals and nested user/entity objects.
+inline std::string twitter_like(size_t target_bytes, uint64_t seed = 2) {
+    static const char* const accents[] = {"é", "ñ", "ü", "日本", "\U0001F600"};
+    static const char* const escapes[] = {"\\n", "\\\"", "\\/", "\\u00e9", "\\u3042"};
+    Random rnd(seed);
+    std::string out = R"({"statuses":[)";
+    uint64_t id = 250075927172759552ull;
+    for (size_t n = 0; out.size() < target_bytes; ++n) {
+        if (n != 0)
+            out.push_back(',');
+        id += 1 + rnd.uniform(1000000);
+        out += R"({"created_at":"Mon Sep 24 03:35:)" + std::to_string(10 + rnd.uniform(50)) + R"( +0000 2012")";
+        out += R"(,"id":)" + std::to_string(id) + R"(,"id_str":")" + std::to_string(id) + R"(","text":")";
+        for (size_t i = 0, words = 6 + rnd.uniform(20); i < words; ++i) {
+            if (i != 0)
+                out.push_back(' ');
+            switch (rnd.uniform(10)) {
+                case 0: out += accents[rnd.uniform(std::size(accents))]; break;
+                case 1: out += escapes[rnd.uniform(std::size(escapes))]; break;
+                case 2: out.push_back('#'); append_word(out, rnd, 3, 10); break;
+                default: append_word(out, rnd, 1, 9); break;
+            }
+        }
+        out += R"(","source":"<a href=\"http:\/\/twitter.com\" rel=\"nofollow\">Twitter for iPhone<\/a>")";
+        out += R"(,"truncated":false,"in_reply_to_status_id":null,"user":{"id":)" + std::to_string(rnd.uniform(1000000000));
+        out += R"(,"name":")";
+        append_word(out, rnd, 3, 10);
+        out += R"(","screen_name":")";
+        append_word(out, rnd, 5, 15);
+        out += R"(","description":")";
+        append_text(out, rnd, rnd.uniform(15));
+        out += R"(","url":"http:\/\/)";
+        append_word(out, rnd, 4, 10);
+        out += R"(.com","followers_count":)" + std::to_string(rnd.uniform(100000));
+        out += R"(,"verified":)";
+        out += rnd.uniform(10) == 0 ? "true" : "false";
+        out += R"(,"lang":"en"},"entities":{"hashtags":[)";
+        for (size_t i = 0, tags = rnd.uniform(3); i < tags; ++i) {
+            if (i != 0)
+                out.push_back(',');
+            out += R"({"text":")";
+            append_word(out, rnd, 3, 10);
+            size_t at = rnd.uniform(100);
+            out += R"(","indices":[)" + std::to_string(at) + "," + std::to_string(at + 5) + "]}";
+        }
+        out += R"(],"urls":[],"user_mentions":[]},"retweet_count":)" + std::to_string(rnd.uniform(100));
+        out += R"(,"favorited":false,"lang":"en"})";
+    }
+    out += R"(],"search_metadata":{"completed_in":0.087,"max_id":)" + std::to_string(id) + R"(,"count":100}})";
+    return out;
+}
+
+// Like citm_catalog.json: objects keyed by numeric ids, many small objects
+// with integer members and null, short ASCII strings.
+inline std::string citm_like(size_t target_bytes, uint64_t seed = 3) {
+    Random rnd(seed);
+    std::string out = R"({"areaNames":{)";
+    for (int i = 0; i < 16; ++i) {
+        if (i != 0)
+            out.push_back(',');
+        out += "\"" + std::to_string(205705993 + i) + "\":\"";
+        append_text(out, rnd, 1 + rnd.uniform(3));
+        out.push_back('"');
+    }
+    out += R"(},"performances":[)";
+    for (size_t n = 0; out.size() < target_bytes; ++n) {
+        if (n != 0)
+            out.push_back(',');
+        out += R"({"eventId":)" + std::to_string(138586341 + rnd.uniform(200));
+        out += R"(,"id":)" + std::to_string(339887544 + n);
+        out += R"(,"logo":null,"name":null,"prices":[)";
+        for (size_t i = 0, prices = 1 + rnd.uniform(4); i < prices; ++i) {
+            if (i != 0)
+                out.push_back(',');
+            out += R"({"amount":)" + std::to_string(10000 + rnd.uniform(100000));
+            out += R"(,"audienceSubCategoryId":337100890,"seatCategoryId":)" + std::to_string(338937295 + rnd.uniform(10)) + "}";
+        }
+        out += R"(],"seatCategories":[)";
+        for (size_t i = 0, categories = 1 + rnd.uniform(4); i < categories; ++i) {
+            if (i != 0)
+                out.push_back(',');
+            out += R"({"areas":[)";
+            for (size_t j = 0, areas = 1 + rnd.uniform(6); j < areas; ++j) {
+                if (j != 0)
+                    out.push_back(',');
+                out += R"({"areaId":)" + std::to_string(205705993 + rnd.uniform(16)) + R"(,"blockIds":[]})";
+            }
+            out += R"(],"seatCategoryId":)" + std::to_string(338937295 + i) + "}";
+        }
+        out += R"(],"seatMapImage":null,"start":)" + std::to_string(1372701600000ull + rnd.uniform(100000000));
+        out += R"(,"venueCode":"PLEYEL_PLEYEL"})";
+    }
+    out += "]}";
+    return out;
+}
+
+// Like canada.json: one GeoJSON polygon, nearly all of it arrays of
+// coordinate pairs printed with 15 to 17 significant digits.
+inline std::string canada_like(size_t target_bytes, uint64_t seed = 4) {
+    Random rnd(seed);
+    std::string out = R"({"type":"FeatureCollection","features":[{"type":"Feature","properties":{"name":"Canada"},)"
+        R"("geometry":{"type":"Polygon","coordinates":[)";
+    char buf[32];
+    for (size_t ring = 0; out.size() < target_bytes; ++ring) {
+        if (ring != 0)
+            out.push_back(',');
+        out.push_back('[');
+        for (size_t i = 0; i < 256; ++i) {
+            if (i != 0)
+                out.push_back(',');
+            double lon = -141.0 + double(rnd.uniform(1ull << 53)) / double(1ull << 53) * 88.0;
+            double lat = 41.0 + double(rnd.uniform(1ull << 53)) / double(1ull << 53) * 42.0;
+            std::snprintf(buf, sizeof(buf), "[%.*g,", 15 + int(rnd.uniform(3)), lon);
+            out += buf;
+            std::snprintf(buf, sizeof(buf), "%.*g]", 15 + int(rnd.uniform(3)), lat);
+            out += buf;
+        }
+        out.push_back(']');
+    }
+    out += "]}}]}";
+    return out;
+}
+
+// JSON Lines: small twitter-like records, one per line; every bad_every-th
+// one cut short (0: none).
+inline std::string json_lines(size_t target_bytes, size_t bad_every = 0) {
+    std::string out;
+    for (uint64_t seed = 1; out.size() < target_bytes; ++seed) {
+        std::string record = twitter_like(2000, seed);
+        if (bad_every != 0 && seed % bad_every == 0)
+            record.resize(record.size() / 2);
+        out += record;
+        out.push_back('\n');
+    }
+    return out;
+}
+
+// Re-indents a minified document the way pretty printers do: one member or
+// element per line, width spaces per nesting level.
+inline std::string indent(std::string_view json, int width = 4) {
+    std::string out;
+    out.reserve(json.size() * 2);
+    int depth = 0;
+    bool in_string = false;
+    auto newline = [&]() {
+        out.push_back('\n');
+        out.append(static_cast<size_t>(depth * width), ' ');
+    };
+    for (size_t i = 0; i < json.size(); ++i) {
+        char c = json[i];
+        if (in_string) {
+            out.push_back(c);
+            if (c == '\\' && i + 1 < json.size())
+                out.push_back(json[++i]);
+            else if (c == '"')
+                in_string = false;
+            continue;
+        }
+        switch (c) {
+            case '"':
+                in_string = true;
+                out.push_back(c);
+                break;
+            case '{':
+            case '[':
+                out.push_back(c);
+                ++depth;
+                newline();
+                break;
+            case '}':
+            case ']':
+                --depth;
+                newline();
+                out.push_back(c);
+                break;
+            case ',':
+                out.push_back(c);
+                newline();
+                break;
+            case ':':
+                out += ": ";
+                break;
+            default:
+                out.push_back(c);
+                break;
+        }
+    }
+    return out;
+}
+
+inline double whitespace_ratio(std::string_view json) {
+    size_t ws = 0;
+    for (char c: json)
+        ws += (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+    return json.empty() ? 0 : double(ws) / json.size();
+}
+
+} // namespace libacpp::json::bench::corpus
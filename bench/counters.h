@@ -0,0 +1,149 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "bench.h"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define ACPPJSON_BENCH_PERF 1
+#endif
+
+namespace libacpp::json::bench {
+
+struct CounterValues {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t branch_misses = 0;
+};
+
+// User space hardware counters of the calling thread, read with
+// perf_event_open as one group. available() is false where the kernel,
+// the VM or perf_event_paranoid do not allow it (and on other systems);
+// callers then fall back to the time stamp counter or steady_clock.
+class PerfCounters {
+public:
+    PerfCounters() {
+#if defined(ACPPJSON_BENCH_PERF)
+        leader_ = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (leader_ < 0)
+            return;
+        instructions_ = open(PERF_COUNT_HW_INSTRUCTIONS, leader_);
+        branch_misses_ = open(PERF_COUNT_HW_BRANCH_MISSES, leader_);
+        if (instructions_ < 0 || branch_misses_ < 0)
+            close_all();
+#endif
+    }
+
+    ~PerfCounters() { close_all(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return leader_ >= 0; }
+
+    void start() {
+#if defined(ACPPJSON_BENCH_PERF)
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    CounterValues stop() {
+        CounterValues v;
+#if defined(ACPPJSON_BENCH_PERF)
+        ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // PERF_FORMAT_GROUP: the number of counters, then their values in
+        // the order they were opened
+        uint64_t data[4] = {};
+        if (::read(leader_, data, sizeof(data)) == sizeof(data) && data[0] == 3) {
+            v.cycles = data[1];
+            v.instructions = data[2];
+            v.branch_misses = data[3];
+        }
+#endif
+        return v;
+    }
+
+private:
+#if defined(ACPPJSON_BENCH_PERF)
+    static int open(uint64_t config, int group) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+#endif
+
+    void close_all() {
+#if defined(ACPPJSON_BENCH_PERF)
+        for (int* fd: {&branch_misses_, &instructions_, &leader_}) {
+            if (*fd >= 0)
+                ::close(*fd);
+            *fd = -1;
+        }
+#endif
+    }
+
+    int leader_ = -1;
+    int instructions_ = -1;
+    int branch_misses_ = -1;
+};
+
+inline PerfCounters& perf_counters() {
+    static PerfCounters counters;
+    return counters;
+}
+
+struct CountedMeasurement: Measurement {
+    bool counted = false;   // counters hold hardware counts
+    CounterValues counters; // of the fastest iteration
+};
+
+// measure() plus the hardware counters of the fastest iteration, when the
+// system provides them.
+template <typename F>
+CountedMeasurement measure_counted(size_t bytes, F&& fn, double min_seconds = 0.25, size_t min_iterations = 5) {
+    using clock = std::chrono::steady_clock;
+    PerfCounters& perf = perf_counters();
+    CountedMeasurement m;
+    m.bytes = bytes;
+    m.counted = perf.available();
+    fn();
+    auto start = clock::now();
+    while (m.iterations < min_iterations
+        || std::chrono::duration<double>(clock::now() - start).count() < min_seconds) {
+        if (m.counted)
+            perf.start();
+        auto t0 = clock::now();
+        uint64_t c0 = ticks();
+        fn();
+        uint64_t c1 = ticks();
+        double s = std::chrono::duration<double>(clock::now() - t0).count();
+        CounterValues v = m.counted ? perf.stop() : CounterValues{};
+        if (m.iterations == 0 || s < m.seconds) {
+            m.seconds = s;
+            m.ticks = c1 - c0;
+            m.counters = v;
+        }
+        ++m.iterations;
+    }
+    return m;
+}
+
+} // namespace libacpp::json::bench
@@ -0,0 +1,75 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <string>
+
+#include <libacpp-json/arena.h>
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/tape.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+void run(const std::string& label, const std::string& doc, JsonConsumer::Strings strings) {
+    bench::report(label, bench::measure(doc.size(), [&]() {
+        JsonConsumer consumer(strings);
+        ValueParser<JsonConsumer> parser(consumer);
+        const char* p = doc.data();
+        bench::do_not_optimize(parser.parse(p, p + doc.size()));
+    }));
+}
+
+// One consumer over an arena reused for every document, interning the keys
+// in keys when given.
+void run_arena(const std::string& label, const std::string& doc, JsonConsumer::Strings strings, bool huge_pages,
+    KeyTable* keys = nullptr, bool lazy_numbers = false) {
+    JsonArena arena(JsonArena::default_block_size, huge_pages);
+    JsonConsumer consumer(arena, strings);
+    consumer.set_key_table(keys);
+    consumer.set_lazy_numbers(lazy_numbers);
+    bench::report(label, bench::measure(doc.size(), [&]() {
+        consumer.reset();
+        ValueParser<JsonConsumer> parser(consumer);
+        const char* p = doc.data();
+        bench::do_not_optimize(parser.parse(p, p + doc.size()));
+    }));
+}
+
+// One tape reused for every document.
+void run_tape(const std::string& label, const std::string& doc) {
+    Tape tape;
+    TapeConsumer consumer(tape);
+    bench::report(label, bench::measure(doc.size(), [&]() {
+        consumer.reset();
+        ValueParser<TapeConsumer> parser(consumer);
+        const char* p = doc.data();
+        bench::do_not_optimize(parser.parse(p, p + doc.size()));
+    }));
+}
+
+} // namespace
+
+// Whole-document DOM building through JsonConsumer.
+ACPPJSON_BENCH(dom) {
+    std::string doc = bench::corpus::mixed(1 << 20);
+    run("dom/strings-copy", doc, JsonConsumer::Strings::copy);
+    run("dom/strings-view", doc, JsonConsumer::Strings::view);
+    run_arena("dom/arena-copy", doc, JsonConsumer::Strings::copy, false);
+    run_arena("dom/arena-view", doc, JsonConsumer::Strings::view, false);
+    run_arena("dom/arena-copy-hugepages", doc, JsonConsumer::Strings::copy, true);
+    KeyTable keys;
+    run_arena("dom/arena-copy-interned", doc, JsonConsumer::Strings::copy, false, &keys);
+    run_arena("dom/arena-copy-lazy-numbers", doc, JsonConsumer::Strings::copy, false, nullptr, true);
+    std::string numbers = bench::corpus::canada_like(1 << 20);
+    run_arena("dom/numbers/arena", numbers, JsonConsumer::Strings::copy, false);
+    run_arena("dom/numbers/arena-lazy", numbers, JsonConsumer::Strings::copy, false, nullptr, true);
+    run_tape("dom/tape", doc);
+}
@@ -0,0 +1,64 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <memory>
+#include <string>
+
+#include <libacpp-json/indexed_parser.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/simd.h>
+#include <libacpp-json/stack_parser.h>
+#include <libacpp-json/structural.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+void run(const std::string& label, const std::string& doc) {
+    const char* begin = doc.data();
+    const char* end = begin + doc.size();
+
+    std::unique_ptr<uint32_t[]> positions(new uint32_t[doc.size() + simd::structurals_padding]);
+    bench::report(label + "/stage1-scalar", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(simd::find_structurals_scalar(begin, end, positions.get()));
+    }));
+    bench::report(label + "/stage1-sse2", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(simd::find_structurals_sse2(begin, end, positions.get()));
+    }));
+    if (simd::has_avx2()) {
+        bench::report(label + "/stage1-avx2", bench::measure(doc.size(), [&]() {
+            bench::do_not_optimize(simd::find_structurals_avx2(begin, end, positions.get()));
+        }));
+    }
+
+    bench::NullConsumer consumer;
+    IndexedParser<bench::NullConsumer> indexed(consumer);
+    bench::report(label + "/IndexedParser", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(indexed.parse(begin, end));
+    }));
+    bench::report(label + "/StackParser", bench::measure(doc.size(), [&]() {
+        StackParser<bench::NullConsumer> parser(consumer);
+        const char* p = begin;
+        bench::do_not_optimize(parser.parse(p, end));
+    }));
+    bench::report(label + "/ValueParser", bench::measure(doc.size(), [&]() {
+        ValueParser<bench::NullConsumer> parser(consumer);
+        const char* p = begin;
+        bench::do_not_optimize(parser.parse(p, end));
+    }));
+}
+
+} // namespace
+
+ACPPJSON_BENCH(indexed) {
+    std::string doc = bench::corpus::mixed(4 << 20);
+    run("minified", doc);
+    run("pretty", bench::corpus::indent(doc));
+}
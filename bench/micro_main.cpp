@@ -0,0 +1,24 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstdio>
+#include <string>
+
+#include "bench.h"
+
+// usage: acppJsonMicroBench [filter]
+// runs every registered benchmark whose name contains filter
+int main(int argc, char** argv) {
+    using namespace libacpp::json::bench;
+    std::string filter = argc > 1 ? argv[1] : "";
+    for (auto& [name, fn]: registry()) {
+        if (name.find(filter) == std::string::npos)
+            continue;
+        std::printf("== %s\n", name.c_str());
+        fn();
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace libacpp::json::bench {
+
+// Accepts every event and does nothing with it, so that benchmarks measure
+// the parser alone.
+class NullConsumer {
+public:
+    void string_begin() {}
+    void add_char_string(char) {}
+    void add_chars_string(std::string_view) {}
+    void string_end() {}
+
+    void key_begin() {}
+    void add_char_key(char) {}
+    void add_chars_key(std::string_view) {}
+    void key_end() {}
+
+    void number_value(int64_t) {}
+    void number_value(uint64_t) {}
+    void number_value(double) {}
+
+    void set_bool(bool) {}
+    void set_null() {}
+
+    void object_begin() {}
+    void object_end() {}
+    void array_begin() {}
+    void array_end() {}
+
+    typedef NullConsumer KeyConsumerType;
+    typedef NullConsumer ValueConsumerType;
+    typedef NullConsumer KeyValueConsumerType;
+    typedef NullConsumer NumberConsumerType;
+    typedef NullConsumer StringConsumerType;
+    typedef NullConsumer ObjectConsumerType;
+    typedef NullConsumer ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+};
+
+} // namespace libacpp::json::bench
@@ -0,0 +1,120 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include <libacpp-json/parser.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+// Character mode consumer doing the minimum to build a value, like the
+// JsonConsumer did before number_value(): integer digits only.
+class CharNumberConsumer {
+public:
+    void number_begin() { int_ = 0; sign_ = 1;}
+    void sign(int s) { sign_ = s;}
+    void add_char_int(char c) { int_ = int_ * 10 + sign_ * (c - '0');}
+    void add_char_frac(char) {}
+    void add_char_exp(char) {}
+    void number_end() { sum_ += int_;}
+    double sum() const { return sum_;}
+private:
+    int64_t int_ = 0;
+    int sign_ = 1;
+    double sum_ = 0;
+};
+
+class ValueNumberConsumer {
+public:
+    void number_value(int64_t v) { sum_ += v;}
+    void number_value(uint64_t v) { sum_ += v;}
+    void number_value(double v) { sum_ += v;}
+    double sum() const { return sum_;}
+private:
+    double sum_ = 0;
+};
+
+// Comma separated numbers, as found in telemetry arrays.
+std::string numbers(int kind, size_t target_bytes) {
+    bench::corpus::Random rnd(11);
+    std::string out;
+    while (out.size() < target_bytes) {
+        switch (kind) {
+            case 0: // counters and ids
+                out += std::to_string(rnd.uniform(1000000000));
+                break;
+            case 1: // timestamps in nanoseconds
+                out += std::to_string(1700000000000000000ull + rnd.uniform(1000000000000ull));
+                break;
+            default: // sensor readings
+                if (rnd.uniform(2))
+                    out.push_back('-');
+                out += std::to_string(rnd.uniform(1000)) + ".";
+                for (size_t i = 0, n = 1 + rnd.uniform(9); i < n; ++i)
+                    out.push_back(static_cast<char>('0' + rnd.uniform(10)));
+                if (rnd.uniform(4) == 0)
+                    out += "e-" + std::to_string(rnd.uniform(20));
+                break;
+        }
+        out.push_back(',');
+    }
+    return out;
+}
+
+template <typename Consumer>
+double parse_all(const std::string& doc) {
+    Consumer consumer;
+    NumberParser<Consumer> parser(consumer);
+    const char* p = doc.data();
+    const char* end = p + doc.size();
+    while (p != end) {
+        parser.reset();
+        if (parser.parse(p, end) != ParseResult::ok)
+            break;
+        ++p; // ','
+    }
+    return consumer.sum();
+}
+
+double strtod_all(const std::string& doc) {
+    const char* p = doc.data();
+    const char* end = p + doc.size();
+    double sum = 0;
+    while (p < end) {
+        char* next;
+        sum += std::strtod(p, &next);
+        p = next + 1;
+    }
+    return sum;
+}
+
+void run(const std::string& label, const std::string& doc) {
+    bench::report(label + "/char-events", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(parse_all<CharNumberConsumer>(doc));
+    }));
+    bench::report(label + "/number_value", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(parse_all<ValueNumberConsumer>(doc));
+    }));
+    bench::report(label + "/strtod", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(strtod_all(doc));
+    }));
+}
+
+} // namespace
+
+ACPPJSON_BENCH(numbers) {
+    const size_t size = 1 << 20;
+    run("integers", numbers(0, size));
+    run("timestamps", numbers(1, size));
+    run("decimals", numbers(2, size));
+}
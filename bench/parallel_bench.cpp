@@ -0,0 +1,82 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/document_stream.h>
+#include <libacpp-json/parallel.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+// builds the DOM of every record and counts them
+struct Worker {
+    Worker(): stream(consumer, *this) {}
+
+    size_t parse(std::string_view slice) {
+        const char* p = slice.data();
+        documents = 0;
+        stream.parse(p, p + slice.size());
+        stream.finish();
+        return documents;
+    }
+
+    void document_end() { ++documents; }
+
+    JsonConsumer consumer;
+    DocumentStream<JsonConsumer, Worker> stream;
+    size_t documents = 0;
+};
+
+} // namespace
+
+// JSON Lines into a DOM per record on 1 to hardware_concurrency() threads,
+// 1 MiB slices, delivered in order and as they come.
+ACPPJSON_BENCH(parallel) {
+    const std::string lines = bench::corpus::json_lines(1 << 25);
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; ; threads = std::min(threads * 2, cores)) {
+        for (bool ordered: {true, false}) {
+            ParallelLineParser<Worker> parser({threads, 1 << 20, ordered});
+            const std::string name = "parallel/lines/" + std::to_string(threads) + (ordered ? "/ordered" : "/unordered");
+            bench::report(name, bench::measure(lines.size(), [&]() {
+                size_t documents = 0;
+                parser.parse(lines, [&](size_t, size_t n) { documents += n; });
+                bench::do_not_optimize(documents);
+            }));
+        }
+        if (threads == cores)
+            break;
+    }
+}
+
+// One large array of records into a DOM: sequentially, and split on 1 to
+// hardware_concurrency() threads in 1 MiB ranges.
+ACPPJSON_BENCH(parallel_array) {
+    const std::string array = bench::corpus::mixed(1 << 25);
+    bench::report("parallel/array/sequential", bench::measure(array.size(), [&]() {
+        JsonConsumer consumer;
+        ValueParser<JsonConsumer> parser(consumer);
+        const char* p = array.data();
+        bench::do_not_optimize(parser.parse(p, p + array.size()));
+    }));
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; ; threads = std::min(threads * 2, cores)) {
+        bench::report("parallel/array/" + std::to_string(threads), bench::measure(array.size(), [&]() {
+            JsonConsumer consumer;
+            bench::do_not_optimize(parse_array_parallel(array, consumer, {threads, 1 << 20}).ranges);
+        }));
+        if (threads == cores)
+            break;
+    }
+}
@@ -0,0 +1,50 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <string>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/path.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+// One lookup per status of a twitter-like document (the document size as
+// the unit): chained find() calls, a pointer parsed at every lookup, and a
+// compiled JsonPath reused for all of them.
+ACPPJSON_BENCH(path) {
+    const std::string doc = bench::corpus::twitter_like(1 << 20);
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> parser(consumer);
+    const char* p = doc.data();
+    parser.parse(p, p + doc.size());
+    const JsonArray& statuses = std::get<JsonArray>(std::get<JsonObject>(consumer.root()).at("statuses"));
+
+    bench::report("path/twitter/find", bench::measure(doc.size(), [&]() {
+        int64_t sum = 0;
+        for (const JsonValue& status: statuses) {
+            const JsonObject& user = std::get<JsonObject>(std::get<JsonObject>(status).at("user"));
+            sum += std::get<int64_t>(user.at("followers_count"));
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::report("path/twitter/pointer", bench::measure(doc.size(), [&]() {
+        int64_t sum = 0;
+        for (const JsonValue& status: statuses)
+            sum += std::get<int64_t>(*find_pointer(status, "/user/followers_count"));
+        bench::do_not_optimize(sum);
+    }));
+    const JsonPath path = JsonPath::pointer("/user/followers_count");
+    bench::report("path/twitter/compiled", bench::measure(doc.size(), [&]() {
+        int64_t sum = 0;
+        for (const JsonValue& status: statuses)
+            sum += std::get<int64_t>(*path.find(status));
+        bench::do_not_optimize(sum);
+    }));
+}
@@ -0,0 +1,112 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/reader.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+constexpr size_t chunk_size = 64 << 10;
+
+// all of doc through reader, chunk by chunk; on_token returns whether to
+// skip() after the token
+template <typename F>
+void read(JsonReader& reader, const std::string& doc, F&& on_token) {
+    reader.reset();
+    size_t pos = 0;
+    while (true) {
+        const JsonReader::Token t = reader.next();
+        if (t.kind == JsonReader::Kind::need_input) {
+            if (pos == doc.size()) {
+                reader.finish();
+            } else {
+                const size_t n = std::min(chunk_size, doc.size() - pos);
+                reader.feed(std::string_view(doc).substr(pos, n));
+                pos += n;
+            }
+            continue;
+        }
+        if (t.kind == JsonReader::Kind::end || t.kind == JsonReader::Kind::error)
+            return;
+        if (on_token(t))
+            reader.skip();
+    }
+}
+
+} // namespace
+
+// An array of records in 64 KiB chunks: every event pushed to a consumer
+// that drops them, every token pulled, and only "id", "score" and "active"
+// of each record pulled with the other members skipped; the same three
+// fields looked up in a DOM of each record for reference.
+ACPPJSON_BENCH(reader) {
+    const std::string doc = bench::corpus::mixed(1 << 24);
+
+    bench::report("reader/push-all", bench::measure(doc.size(), [&]() {
+        bench::NullConsumer consumer;
+        ValueParser<bench::NullConsumer> parser(consumer);
+        for (size_t pos = 0; pos < doc.size(); pos += chunk_size) {
+            const char* p = doc.data() + pos;
+            parser.parse(p, doc.data() + std::min(pos + chunk_size, doc.size()));
+        }
+    }));
+
+    JsonReader reader;
+    bench::report("reader/pull-all", bench::measure(doc.size(), [&]() {
+        size_t tokens = 0;
+        read(reader, doc, [&](const JsonReader::Token&) {
+            ++tokens;
+            return false;
+        });
+        bench::do_not_optimize(tokens);
+    }));
+
+    bench::report("reader/pull-3-fields", bench::measure(doc.size(), [&]() {
+        double sum = 0;
+        std::string_view field;
+        read(reader, doc, [&](const JsonReader::Token& t) {
+            if (t.kind == JsonReader::Kind::key) {
+                field = t.text;
+                return field != "id" && field != "score" && field != "active";
+            }
+            if (t.kind == JsonReader::Kind::number)
+                sum += std::visit([](auto v) { return static_cast<double>(v); }, t.number);
+            else if (t.kind == JsonReader::Kind::boolean)
+                sum += t.boolean;
+            return false;
+        });
+        bench::do_not_optimize(sum);
+    }));
+
+    bench::report("reader/dom-3-fields", bench::measure(doc.size(), [&]() {
+        JsonConsumer consumer;
+        ValueParser<JsonConsumer> parser(consumer);
+        for (size_t pos = 0; pos < doc.size(); pos += chunk_size) {
+            const char* p = doc.data() + pos;
+            parser.parse(p, doc.data() + std::min(pos + chunk_size, doc.size()));
+        }
+        double sum = 0;
+        for (const JsonValue& record: std::get<JsonArray>(consumer.root())) {
+            const JsonObject& object = std::get<JsonObject>(record);
+            sum += static_cast<double>(std::get<int64_t>(object.find("id")->second));
+            sum += std::get<double>(object.find("score")->second);
+            sum += std::get<bool>(object.find("active")->second);
+        }
+        bench::do_not_optimize(sum);
+    }));
+}
@@ -0,0 +1,44 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <string>
+
+#include <libacpp-json/document_stream.h>
+#include <libacpp-json/parser.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+void run(const std::string& label, const std::string& doc, Framing framing, size_t chunk) {
+    bench::report(label, bench::measure(doc.size(), [&]() {
+        bench::NullConsumer consumer;
+        DocumentStream<bench::NullConsumer> stream(consumer, framing);
+        const char* p = doc.data();
+        const char* end = p + doc.size();
+        while (p != end)
+            stream.parse(p, std::min(p + chunk, end));
+        stream.finish();
+        bench::do_not_optimize(stream.documents());
+    }));
+}
+
+} // namespace
+
+// JSON Lines through a DocumentStream in 64 KiB reads: well-formed, with 1
+// record in 20 malformed (skipped to the next line), and the same records
+// as concatenated documents.
+ACPPJSON_BENCH(stream) {
+    const std::string good = bench::corpus::json_lines(1 << 22);
+    const std::string bad = bench::corpus::json_lines(1 << 22, 20);
+    run("stream/lines", good, Framing::lines, 64 << 10);
+    run("stream/lines-5%-malformed", bad, Framing::lines, 64 << 10);
+    run("stream/concatenated", good, Framing::concatenated, 64 << 10);
+}
@@ -0,0 +1,154 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/simd.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+#if !defined(ACPPJSON_VERSION)
+    #define ACPPJSON_VERSION "unknown"
+#endif
+
+// End to end throughput of whole documents, fed in one buffer or in fixed
+// size chunks, over generated corpora shaped like the usual JSON benchmark
+// files.
+//
+// usage: acppJsonBench [--json] [--size=BYTES] [--min-time=SECONDS] [filter]
+//   --json       print the results as one JSON object instead of a table
+//   --size       target size of each corpus (default 1 MiB)
+//   --min-time   minimum measuring time per case (default 0.25 s)
+//   filter       only run the cases whose name contains it
+
+using namespace libacpp::json;
+
+namespace {
+
+struct Options {
+    bool json = false;
+    size_t size = 1 << 20;
+    double min_time = 0.25;
+    std::string filter;
+};
+
+struct Result {
+    std::string name;
+    std::string corpus;
+    std::string consumer;
+    size_t chunk;           // 0: whole buffer
+    bench::Measurement m;
+};
+
+// Feeds doc to a fresh parser chunk bytes at a time (all at once for 0).
+template <typename Consumer>
+bool parse(const std::string& doc, size_t chunk) {
+    Consumer consumer;
+    ValueParser<Consumer> parser(consumer);
+    const char* p = doc.data();
+    const char* end = p + doc.size();
+    ParseResult r = ParseResult::partial;
+    while (p != end && r == ParseResult::partial) {
+        const char* chunk_end = chunk == 0 || static_cast<size_t>(end - p) <= chunk ? end : p + chunk;
+        r = parser.parse(p, chunk_end);
+    }
+    return r == ParseResult::ok;
+}
+
+std::string chunk_label(size_t chunk) {
+    if (chunk == 0)
+        return "whole";
+    if (chunk % 1024 == 0)
+        return std::to_string(chunk / 1024) + "K";
+    return std::to_string(chunk);
+}
+
+template <typename Consumer>
+void run(const Options& options, const std::string& corpus, const std::string& consumer,
+    const std::string& doc, std::vector<Result>& results) {
+    for (size_t chunk: {size_t{0}, size_t{1}, size_t{16}, size_t{4096}, size_t{65536}}) {
+        std::string name = corpus + "/" + consumer + "/" + chunk_label(chunk);
+        if (name.find(options.filter) == std::string::npos)
+            continue;
+        if (!parse<Consumer>(doc, chunk)) {
+            std::fprintf(stderr, "%s: parse failed\n", name.c_str());
+            std::exit(1);
+        }
+        bench::Measurement m = bench::measure(doc.size(), [&]() {
+            bench::do_not_optimize(parse<Consumer>(doc, chunk));
+        }, options.min_time);
+        if (!options.json)
+            std::printf("%-32s %10zu B %10.1f MB/s %8.3f B/%s\n", name.c_str(), m.bytes, m.mb_per_s(),
+                m.bytes_per_tick(), bench::tick_unit());
+        results.push_back({name, corpus, consumer, chunk, m});
+    }
+}
+
+void print_json(const Options& options, const std::vector<Result>& results) {
+    std::printf("{\n  \"library\": \"acpp-json\",\n  \"version\": \"%s\",\n", ACPPJSON_VERSION);
+    std::printf("  \"whitespace_kernel\": \"%s\",\n", simd::skip_whitespace_kernel_name());
+    std::printf("  \"corpus_size\": %zu,\n  \"tick_unit\": \"%s\",\n  \"results\": [", options.size,
+        bench::tick_unit());
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("%s\n    {\"name\": \"%s\", \"corpus\": \"%s\", \"consumer\": \"%s\", \"chunk\": %zu, "
+            "\"bytes\": %zu, \"iterations\": %zu, \"seconds\": %.9f, \"ticks\": %llu, \"mb_per_s\": %.3f}",
+            i == 0 ? "" : ",", r.name.c_str(), r.corpus.c_str(), r.consumer.c_str(), r.chunk, r.m.bytes,
+            r.m.iterations, r.m.seconds, static_cast<unsigned long long>(r.m.ticks), r.m.mb_per_s());
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--json")
+            options.json = true;
+        else if (arg.starts_with("--size="))
+            options.size = std::strtoull(argv[i] + 7, nullptr, 10);
+        else if (arg.starts_with("--min-time="))
+            options.min_time = std::strtod(argv[i] + 11, nullptr);
+        else if (arg.starts_with("--"))
+            return false;
+        else
+            options.filter = arg;
+    }
+    return options.size > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--json] [--size=BYTES] [--min-time=SECONDS] [filter]\n", argv[0]);
+        return 2;
+    }
+    struct Corpus {
+        const char* name;
+        std::string doc;
+    } corpora[] = {
+        {"twitter", bench::corpus::twitter_like(options.size)},
+        {"citm", bench::corpus::citm_like(options.size)},
+        {"canada", bench::corpus::canada_like(options.size)},
+    };
+    std::vector<Result> results;
+    for (const Corpus& c: corpora) {
+        run<bench::NullConsumer>(options, c.name, "null", c.doc, results);
+        run<JsonConsumer>(options, c.name, "dom", c.doc, results);
+    }
+    if (options.json)
+        print_json(options, results);
+    return 0;
+}
@@ -0,0 +1,124 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/parser.h>
+
+#include "bench.h"
+#include "corpus.h"
+#include "null_consumer.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+// The top-level dispatch ValueParser used before the first-byte table: every
+// sub-parser is tried in turn until one does not fail. Only meant for whole
+// values in one buffer, which is all the benchmark feeds it.
+template <typename Consumer>
+class TrialValueParser {
+public:
+    TrialValueParser(Consumer& consumer):
+        number_parser_(consumer.number_consumer()),
+        string_parser_(consumer.string_consumer()),
+        consumer_(consumer) {}
+
+    ParseResult parse(const char*& p, const char* end) {
+        null_parser_.reset();
+        true_parser_.reset();
+        false_parser_.reset();
+        number_parser_.reset();
+        string_parser_.reset();
+        ParseResult r = null_parser_.parse(p, end);
+        if (r == ParseResult::ok)
+            consumer_.set_null();
+        if (r == ParseResult::error && (r = true_parser_.parse(p, end)) == ParseResult::ok)
+            consumer_.set_bool(true);
+        if (r == ParseResult::error && (r = false_parser_.parse(p, end)) == ParseResult::ok)
+            consumer_.set_bool(false);
+        if (r == ParseResult::error)
+            r = number_parser_.parse(p, end);
+        if (r == ParseResult::error)
+            r = string_parser_.parse(p, end);
+        if (r == ParseResult::error) {
+            if (!object_parser_)
+                object_parser_ = std::make_unique<ObjectParser<Consumer>>(consumer_.object_consumer());
+            object_parser_->reset();
+            r = object_parser_->parse(p, end);
+        }
+        if (r == ParseResult::error) {
+            if (!array_parser_)
+                array_parser_ = std::make_unique<ArrayParser<Consumer>>(consumer_.array_consumer());
+            array_parser_->reset();
+            r = array_parser_->parse(p, end);
+        }
+        return r;
+    }
+
+private:
+    NullParser null_parser_;
+    TrueParser true_parser_;
+    FalseParser false_parser_;
+    NumberParser<Consumer> number_parser_;
+    StringParser<Consumer, false> string_parser_;
+    std::unique_ptr<ObjectParser<Consumer>> object_parser_;
+    std::unique_ptr<ArrayParser<Consumer>> array_parser_;
+    Consumer& consumer_;
+};
+
+// Space separated top-level values drawn from the given samples.
+std::string values(std::initializer_list<const char*> samples, size_t target_bytes) {
+    bench::corpus::Random rnd(7);
+    std::vector<const char*> v(samples);
+    std::string out;
+    while (out.size() < target_bytes) {
+        out += v[rnd.uniform(v.size())];
+        out.push_back(' ');
+    }
+    return out;
+}
+
+template <typename Parser>
+size_t parse_all(const std::string& doc) {
+    bench::NullConsumer consumer;
+    Parser parser(consumer);
+    WhiteSpaceParser wsp;
+    const char* p = doc.data();
+    const char* end = p + doc.size();
+    size_t n = 0;
+    while (wsp.parse(p, end) == ParseResult::ok) {
+        if constexpr (requires { parser.reset(); })
+            parser.reset();
+        if (parser.parse(p, end) != ParseResult::ok)
+            break;
+        ++n;
+    }
+    return n;
+}
+
+void run(const std::string& label, const std::string& doc) {
+    bench::report(label + "/trial", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(parse_all<TrialValueParser<bench::NullConsumer>>(doc));
+    }));
+    bench::report(label + "/first-byte", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(parse_all<ValueParser<bench::NullConsumer>>(doc));
+    }));
+}
+
+} // namespace
+
+ACPPJSON_BENCH(value_dispatch) {
+    const size_t size = 1 << 20;
+    run("literals", values({"null", "true", "false"}, size));
+    run("numbers", values({"1", "12345", "-17", "3.25", "6.02e23"}, size));
+    run("strings", values({R"("a")", R"("hello")", R"("some longer text value")"}, size));
+    run("objects", values({R"({"a":1})", R"({"k":"v","n":null})", "{}"}, size));
+    run("arrays", values({"[1,2]", R"(["x"])", "[]"}, size));
+    run("mixed", values({"null", "true", "12345", "-3.5", R"("hello")", R"({"a":1})", "[1,2]"}, size));
+}
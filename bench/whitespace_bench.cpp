@@ -0,0 +1,90 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/parser.h>
+#include <libacpp-json/simd.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+bool is_structural(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+// Positions where the parsers ask for whitespace to be skipped: after every
+// structural character and after every scalar token. Minified input mostly
+// gives empty runs there, indented input long ones.
+std::vector<size_t> token_ends(const std::string& doc) {
+    std::vector<size_t> ends;
+    for (size_t i = 1; i < doc.size(); ++i) {
+        char prev = doc[i - 1];
+        if (simd::is_whitespace(prev))
+            continue;
+        if (is_structural(prev) || simd::is_whitespace(doc[i]) || is_structural(doc[i]))
+            ends.push_back(i);
+    }
+    return ends;
+}
+
+template <typename Skip>
+size_t walk(const std::string& doc, const std::vector<size_t>& ends, Skip skip) {
+    const char* begin = doc.data();
+    const char* end = begin + doc.size();
+    size_t skipped = 0;
+    for (size_t pos: ends)
+        skipped += skip(begin + pos, end) - (begin + pos);
+    return skipped;
+}
+
+void run(const std::string& label, const std::string& doc) {
+    std::vector<size_t> ends = token_ends(doc);
+    std::printf("%s: %zu bytes, %.0f%% whitespace\n", label.c_str(), doc.size(),
+        bench::corpus::whitespace_ratio(doc) * 100);
+
+    auto kernel = [&](const char* name, simd::skip_whitespace_fn fn) {
+        bench::report(label + "/" + name, bench::measure(doc.size(), [&]() {
+            bench::do_not_optimize(walk(doc, ends, fn));
+        }));
+    };
+    // the byte-at-a-time loop WhiteSpaceParser used before the kernels
+    bench::report(label + "/inline-loop", bench::measure(doc.size(), [&]() {
+        bench::do_not_optimize(walk(doc, ends, [](const char* p, const char* end) {
+            while (p != end && simd::is_whitespace(*p))
+                ++p;
+            return p;
+        }));
+    }));
+    kernel("scalar", simd::skip_whitespace_scalar);
+    if (simd::has_sse2())
+        kernel("sse2", simd::skip_whitespace_sse2);
+    if (simd::has_avx2())
+        kernel("avx2", simd::skip_whitespace_avx2);
+
+    bench::report(label + "/WhiteSpaceParser(" + simd::skip_whitespace_kernel_name() + ")",
+        bench::measure(doc.size(), [&]() {
+            WhiteSpaceParser wsp;
+            bench::do_not_optimize(walk(doc, ends, [&](const char* p, const char* end) {
+                wsp.parse(p, end);
+                return p;
+            }));
+        }));
+}
+
+} // namespace
+
+ACPPJSON_BENCH(whitespace) {
+    std::string minified = bench::corpus::mixed(4 << 20);
+    run("minified", minified);
+    run("indented", bench::corpus::indent(minified));
+}
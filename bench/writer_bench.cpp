@@ -0,0 +1,117 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <sstream>
+#include <string>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/writer.h>
+
+#include "bench.h"
+#include "corpus.h"
+
+using namespace libacpp::json;
+
+namespace {
+
+// The serializer to_string used before WriteBuffer: iostreams, doubles
+// through std::to_string and strings unescaped. Kept as the baseline.
+void stream_to_string(const JsonValue& jv, std::stringstream& ss) {
+    std::visit([&](auto&& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            ss << (value ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, double>) {
+            ss << std::to_string(value);
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            ss << "null";
+        } else if constexpr (std::is_same_v<T, JsonString>) {
+            ss << '"' << value << '"';
+        } else if constexpr (std::is_same_v<T, JsonStringRef>) {
+            ss << '"' << value.view() << '"';
+        } else if constexpr (std::is_same_v<T, JsonRawNumber>) {
+            ss << value.text();
+        } else if constexpr (std::is_same_v<T, JsonObject>) {
+            ss << "{";
+            bool first = true;
+            for (auto& p: value) {
+                if (!first)
+                    ss << ",";
+                first = false;
+                ss << '"' << p.first << "\":";
+                stream_to_string(p.second, ss);
+            }
+            ss << "}";
+        } else if constexpr (std::is_same_v<T, JsonArray>) {
+            ss << "[";
+            bool first = true;
+            for (auto& p: value) {
+                if (!first)
+                    ss << ",";
+                first = false;
+                stream_to_string(p, ss);
+            }
+            ss << "]";
+        }
+    }, static_cast<const JsonValue::variant_type&>(jv));
+}
+
+void run(const std::string& corpus, const std::string& doc) {
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> parser(consumer);
+    const char* p = doc.data();
+    parser.parse(p, p + doc.size());
+    const JsonValue& value = consumer.root();
+    // bytes of the output, as the unit for all variants
+    const size_t bytes = to_json(value).size();
+
+    bench::report("writer/" + corpus + "/stringstream", bench::measure(bytes, [&]() {
+        std::stringstream ss;
+        stream_to_string(value, ss);
+        bench::do_not_optimize(ss.str().size());
+    }));
+    WriteBuffer out;
+    bench::report("writer/" + corpus + "/compact", bench::measure(bytes, [&]() {
+        out.clear();
+        write_json(value, out);
+        bench::do_not_optimize(out.size());
+    }));
+    bench::report("writer/" + corpus + "/pretty", bench::measure(bytes, [&]() {
+        out.clear();
+        write_json(value, out, JsonFormat::pretty);
+        bench::do_not_optimize(out.size());
+    }));
+
+    // re-serializing the input: through a DOM, or piping the parser into a
+    // JsonWriter (input bytes as the unit)
+    bench::report("writer/" + corpus + "/reserialize-dom", bench::measure(doc.size(), [&]() {
+        JsonConsumer dom;
+        ValueParser<JsonConsumer> dom_parser(dom);
+        const char* q = doc.data();
+        dom_parser.parse(q, q + doc.size());
+        out.clear();
+        write_json(dom.root(), out);
+        bench::do_not_optimize(out.size());
+    }));
+    bench::report("writer/" + corpus + "/reserialize-pipe", bench::measure(doc.size(), [&]() {
+        out.clear();
+        JsonWriter writer(out);
+        ValueParser<JsonWriter> pipe(writer);
+        const char* q = doc.data();
+        pipe.parse(q, q + doc.size());
+        bench::do_not_optimize(out.size());
+    }));
+}
+
+} // namespace
+
+// Serializing a DOM: the old iostream to_string against WriteBuffer; and
+// parse + write with and without the DOM in between.
+ACPPJSON_BENCH(writer) {
+    run("twitter", bench::corpus::twitter_like(1 << 20));
+    run("canada", bench::corpus::canada_like(1 << 20));
+}
@@ -25,10 +25,11 @@ class LibacppJsonConan(ConanFile):
 
     def requirements(self):
 #        self.test_requires("gtest/1.14.0")
-        self.requires("spdlog/1.12.0", transitive_headers=True)
+        pass
 
     def build_requirements(self):
         self.test_requires("gtest/1.14.0")
+        self.test_requires("spdlog/1.12.0")
 
 
 
@@ -53,6 +54,5 @@ class LibacppJsonConan(ConanFile):
         self.cpp_info.set_property("cmake_file_name", "acpp-json")
         self.cpp_info.set_property("cmake_target_name", "acpp-json::acppJson")
         self.cpp_info.includedirs = ["include"]
-        self.cpp_info.requires = ["spdlog::spdlog"]
         if self.options.shared:
             self.cpp_info.defines.append("ACPPJSON_SHARED")
\ No newline at end of file
@@ -0,0 +1,58 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+namespace libacpp::json {
+
+// Upstream resource handing out whole 2 MiB aligned blocks advised as huge
+// pages (MADV_HUGEPAGE) where the system supports it, the default resource
+// elsewhere.
+std::pmr::memory_resource* huge_page_resource();
+
+// Monotonic memory for one document at a time. Everything allocated from
+// the arena is released at once by release(), without visiting it; the
+// first block is kept for the next document and grown to fit the largest
+// one seen, so a stream of similar messages stops asking upstream for
+// memory after the first few.
+class JsonArena: public std::pmr::memory_resource {
+public:
+    static constexpr size_t default_block_size = 64 << 10;
+
+    explicit JsonArena(size_t block_size = default_block_size, bool huge_pages = false);
+    ~JsonArena() override;
+
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    void release();
+
+    // bytes handed out since the last release
+    size_t used() const { return used_; }
+    // size of the block kept between releases
+    size_t block_size() const { return block_size_; }
+    bool huge_pages() const { return huge_pages_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void allocate_block(size_t size);
+
+    bool huge_pages_;
+    std::pmr::memory_resource* upstream_;
+    void* block_ = nullptr;
+    size_t block_size_ = 0;
+    size_t used_ = 0;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+};
+
+} // namespace libacpp::json
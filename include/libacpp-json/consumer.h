@@ -4,92 +4,128 @@
 //    (See accompanying file LICENSE or copy at
 //          https://www.mozilla.org/en-US/MPL/2.0/)
 
+#pragma once
+
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
-#include <map>
+#include <string_view>
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 #include <variant>
 #include <memory> 
 
+#include <libacpp-json/arena.h>
+#include <libacpp-json/object.h>
 #include <libacpp-json/parser.h>
+#include <libacpp-json/raw_number.h>
+#include <libacpp-json/string_ref.h>
+#include <libacpp-json/writer.h>
 
 
 namespace libacpp::json {
 
+// The containers take a std::pmr allocator, so a whole document can live
+// in a JsonArena. Values keep the resource they were built with when they
+// are moved, not when they are copied. Objects keep their members in
+// document order.
 class JsonValue;
-using JsonObject = std::map<std::string, JsonValue>;
-using JsonArray  = std::vector<JsonValue>;
-
-class JsonValue: public std::variant<std::string, bool, int, double, std::nullptr_t, JsonObject, JsonArray> {
+using JsonString = std::pmr::string;
+using JsonObject = OrderedObject<JsonValue>;
+using JsonArray  = std::pmr::vector<JsonValue>;
+
+// Integers are int64_t, or uint64_t above INT64_MAX; other numbers are
+// double. JsonStringRef only appears in documents parsed with
+// JsonConsumer::Strings::view, JsonRawNumber with lazy numbers.
+class JsonValue: public std::variant<JsonString, bool, int64_t, uint64_t, double, std::nullptr_t, JsonObject, JsonArray,
+    JsonStringRef, JsonRawNumber> {
 public:
-using variant_type = std::variant<std::string, bool, int, double, std::nullptr_t, JsonObject, JsonArray>;
+using variant_type = std::variant<JsonString, bool, int64_t, uint64_t, double, std::nullptr_t, JsonObject, JsonArray,
+    JsonStringRef, JsonRawNumber>;
 
 JsonValue() = default;
 
 template< typename T>
-JsonValue(const T& s):variant_type(s){}   
+REQUIRES((!std::is_same_v<std::decay_t<T>, JsonValue>))
+JsonValue(T&& s):variant_type(std::forward<T>(s)){}   
 
 
 template< typename T>
-void operator=(const T& s) { variant_type::operator=(s); }   
+REQUIRES((!std::is_same_v<std::decay_t<T>, JsonValue>))
+void operator=(T&& s) { variant_type::operator=(std::forward<T>(s)); }   
 
 
  
 };
 
-void to_string(JsonValue& jv, std::stringstream& ss) {
-    std::visit([&](auto&& value) {
-        using T = std::decay_t<decltype(value)>;
-        if constexpr (std::is_same_v<T, bool>) {
-            ss << (value ? "true" : "false");
-        } else if constexpr (std::is_same_v<T, int>) {
-            ss << std::to_string(value);
-        } else if constexpr (std::is_same_v<T, double>) {
-            ss << std::to_string(value);
-        } else if constexpr (std::is_same_v<T, nullptr_t>) {
-            ss <<  "null";
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            ss <<  '"' << value << '"'; // Already a string
-        } else if constexpr (std::is_same_v<T, JsonObject>) {
-            ss << "{";
-            bool first = true;
-            for(auto& p: value)  {
-                if (first) { 
-                    first = false;
-                }
-                else {
-                    ss << ",";
-                }
-                ss << '"' << p.first << "\":";
-                to_string(p.second, ss);
-            }
-            ss << "}";
-        } else if constexpr (std::is_same_v<T, JsonArray>) {
-            ss << "[";
-            bool first = true;
-            for(auto& p: value)  {
-                if (first) { 
-                    first = false;
-                }
-                else {
-                    ss << ",";
-                }
-                to_string(p, ss);
-            }
-            ss << "]";
-        }
-    }, jv);
+// Appends value as JSON text to out: strings escaped, integers exact,
+// doubles in their shortest round trip form.
+void write_json(const JsonValue& value, WriteBuffer& out, JsonFormat format = JsonFormat::compact);
+std::string to_json(const JsonValue& value, JsonFormat format = JsonFormat::compact);
+
+inline void to_string(const JsonValue& jv, std::stringstream& ss) {
+    WriteBuffer out;
+    write_json(jv, out);
+    ss << out.view();
 }
 
 
 
 class JsonConsumer {
 public:
-    JsonConsumer(){
-        path_.push_back(&root_);
+    // copy: string values are owned JsonString.
+    // view: strings whole in the parsed buffer become JsonStringRef views
+    // into it, so the buffer must outlive the document; their escapes are
+    // only decoded when they are read.
+    enum class Strings {copy, view};
+
+    JsonConsumer(Strings strings = Strings::copy)
+    :strings_(strings), member_key_(std::pmr::get_default_resource()),
+    resource_(std::pmr::get_default_resource()), root_(&own_root_) {
+        path_.push_back(root_);
     }
 
+    // Builds the document in arena: releasing the arena frees it at once,
+    // without running the destructors of the values. The consumer must be
+    // reset() or destroyed before the arena is released, and anything
+    // added to the document afterwards must be allocated from resource().
+    JsonConsumer(JsonArena& arena, Strings strings = Strings::copy)
+    :strings_(strings), member_key_(&arena), resource_(&arena), arena_(&arena) {
+        root_ = new_root();
+        path_.push_back(root_);
+    }
+
+    // Drops the document and gets ready for the next one. With an arena the
+    // arena is released: the document goes away in O(1) and its memory is
+    // reused.
+    void reset() {
+        member_key_ = JsonKey(resource_);
+        if (arena_) {
+            arena_->release();
+            root_ = new_root();
+        } else {
+            own_root_ = JsonValue{};
+        }
+        path_.clear();
+        path_.push_back(root_);
+    }
+
+    std::pmr::memory_resource* resource() { return resource_; }
+    Strings strings() const { return strings_; }
+
+    // Interns object keys in table, which must outlive the documents: their
+    // members then hold a pointer to the symbol instead of a string. Keys
+    // past the table's max_size are owned as usual. nullptr stops it.
+    void set_key_table(KeyTable* table) { key_table_ = table; }
+    KeyTable* key_table() { return key_table_; }
+
+    // Stores numbers as JsonRawNumber, their text, converted only when read.
+    void set_lazy_numbers(bool lazy) { lazy_numbers_ = lazy; }
+    bool lazy_numbers() { return lazy_numbers_; }
+
     void add_parent(JsonValue& value) { //TODO: std::move??
         if (auto pv = std::get_if<JsonObject>(&value)) {
             path_.push_back(&value);
@@ -99,16 +135,21 @@ public:
     }
 
 
+    // values (and the pending key) are moved in, never copied: a copy would
+    // write the bytes again, and leave the arena
     template <typename T>
-    void add_value(const T& value) { //TODO: std::move??
+    void add_value(T&& value) {
+        using V = std::decay_t<T>;
         if (auto pv = std::get_if<JsonObject>(&parent())) {
-            (*pv)[key_] = value;
-            add_parent((*pv)[key_]);
+            JsonValue& v = pv->try_emplace(std::move(member_key_)).first->second;
+            v.template emplace<V>(std::forward<T>(value));
+            add_parent(v);
         } else if (auto pv = std::get_if<JsonArray>(&parent())) {
-            (*pv).push_back(JsonValue{value});
+            (*pv).emplace_back(std::forward<T>(value));
             add_parent((*pv).back());
         } else {
-            parent() = value;
+            parent().template emplace<V>(std::forward<T>(value));
+            add_parent(parent());
         }
     }
 
@@ -119,12 +160,23 @@ public:
     void add_char_string(char c) { 
         string_value_.push_back(c);
     }
+    void add_chars_string(std::string_view s) { 
+        string_value_.append(s);
+    }
+    // strings cut by a chunk are gathered in string_value_, which keeps its
+    // capacity, and copied once into an exact allocation
     void string_end() {
-        std::cout << "string_value_: " << string_value_ << std::endl; 
         type_ = ValueType::string; 
-        add_value(string_value_);
+        add_value(JsonString(string_value_, resource_));
 
     }
+    void string_raw(std::string_view raw, bool escaped) {
+        type_ = ValueType::string; 
+        if (strings_ == Strings::view)
+            add_value(JsonStringRef(raw, escaped, resource_));
+        else
+            add_value(make_string(raw, escaped));
+    }
 
     // End String Consumer
 
@@ -135,54 +187,60 @@ public:
     void add_char_key(char c) { 
         key_.push_back(c);
     }
+    void add_chars_key(std::string_view s) { 
+        key_.append(s);
+    }
     void key_end() {
-        std::cout << "string_: " << key_ << std::endl; 
+        if (!intern_key(key_))
+            member_key_ = JsonKey(key_, resource_);
+    }
+    // object keys are always owned or interned
+    void key_raw(std::string_view raw, bool escaped) {
+        if (key_table_) {
+            if (escaped) {
+                unescape(raw, key_);
+                raw = key_;
+            }
+            if (intern_key(raw))
+                return;
+            member_key_ = JsonKey(raw, resource_);
+        } else {
+            member_key_ = JsonKey(make_string(raw, escaped));
+        }
     }
     // End String Consumer
 
 
-    std::string key() { return key_;}
+    std::string key() { return std::string(member_key_.view());}
     std::string string_value() { return string_value_;}
 
     // Number Consumer
-    void number_begin() {
-        int_ = 0;
-        frac_ = 0;
-        exp_ = 0;
-        sign_ = 1;
-    }
-
-
-    void sign(int s) {
-        sign_ = s;
-    } 
-
-    void add_char_int(char c) {
-        int_ = (int_ * 10) + sign_ * (c - '0');
+    void number_value(int64_t v) {
+        type_ = ValueType::number; 
+        add_value(v); 
     }
 
-    void add_char_frac(char c) {
-        frac_ = (frac_ * 10) + (c - '0');
+    void number_value(uint64_t v) {
+        type_ = ValueType::number; 
+        add_value(v); 
     }
 
-    void add_char_exp(char c) {
-        exp_ = (exp_ * 10) + sign_ * (c - '0');
+    void number_value(double v) {
+        type_ = ValueType::number; 
+        add_value(v); 
     }
 
-    void number_end() {
+    // with lazy numbers, keeps the text and skips the conversion
+    bool number_raw(std::string_view text) {
+        if (!lazy_numbers_)
+            return false;
         type_ = ValueType::number; 
-        add_value(int_); 
+        add_value(JsonRawNumber(text, resource_));
+        return true;
     }
-
     // End Number Consumer
 
 
-    int integer() {return int_;}
-    int frac() {return frac_;}
-    int exp() {return exp_;}
-
-
-
     void set_bool(bool v)  { 
         type_ = ValueType::boolean; 
         bool_value_ = v; 
@@ -223,7 +281,7 @@ public:
     void object_begin() {
         object_ = true;
         type_ = ValueType::object; 
-        add_value(JsonObject{});
+        add_value(JsonObject(resource_));
     }
 
     void object_end() {
@@ -235,7 +293,7 @@ public:
     //Begin Array Consumer
     void array_begin() {
         type_ = ValueType::array; 
-        add_value(JsonArray{});
+        add_value(JsonArray(resource_));
     }
 
     void array_end() {
@@ -243,23 +301,53 @@ public:
     }
     //End Array Consumer
     
-    JsonValue& root() { return root_;}
+    JsonValue& root() { return *root_;}
     JsonValue& parent() { return *path_.back();}
 
 private:
-    std::string key_;
+    // A string whole in the buffer, decoded straight into its own
+    // allocation: each byte is written once.
+    JsonString make_string(std::string_view raw, bool escaped) {
+        JsonString s(resource_);
+        if (!escaped) {
+            s.assign(raw);
+        } else {
+            s.reserve(raw.size()); // decoding never makes it longer
+            unescape(raw, s);
+        }
+        return s;
+    }
+
+    bool intern_key(std::string_view key) {
+        if (!key_table_)
+            return false;
+        const KeyTable::Symbol* symbol = key_table_->intern(key);
+        if (!symbol)
+            return false;
+        member_key_ = JsonKey(*symbol, resource_);
+        return true;
+    }
+
+    // the root of an arena document lives in the arena too
+    JsonValue* new_root() {
+        return new (resource_->allocate(sizeof(JsonValue), alignof(JsonValue))) JsonValue();
+    }
 
-    int int_ = 0;
-    int frac_ = 0;
-    int exp_ = 0;
-    int sign_ = 1;
+    Strings strings_;
+    std::string key_;          // a key cut by a chunk, while it arrives
+    JsonKey member_key_;       // the key of the next member
+    KeyTable* key_table_ = nullptr;
+    bool lazy_numbers_ = false;
 
     ValueType type_;
 
     bool bool_value_;
     std::string string_value_;
     bool object_ = false;
-    JsonValue root_;
+    std::pmr::memory_resource* resource_;
+    JsonArena* arena_ = nullptr;
+    JsonValue own_root_;
+    JsonValue* root_;
     std::vector<JsonValue*> path_;
     //JsonValue* current_value_ = &root_;
 };
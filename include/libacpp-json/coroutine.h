@@ -0,0 +1,420 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "document_stream.h"
+#include "parser.h"
+#include "simd.h"
+#include "stack_parser.h"
+#include "string_ref.h"
+
+namespace libacpp::json {
+
+namespace detail {
+
+// StackParser for the consumers it takes, ValueParser for the others
+template <typename Consumer, bool stack = StackConsumerConcept<Consumer>>
+struct DocumentParser {
+    using type = ValueParser<Consumer>;
+};
+
+template <typename Consumer>
+struct DocumentParser<Consumer, true> {
+    using type = StackParser<Consumer>;
+};
+
+} // namespace detail
+
+// Coroutine facade of the push parsers, for code that receives its input
+// in a coroutine (a socket read loop): a reader coroutine awaits documents,
+// suspending when the input runs out, and is resumed when the next chunk
+// arrives:
+//
+//     Task reader(AsyncParser<JsonConsumer>& parser, JsonConsumer& consumer) {
+//         ParseResult r;
+//         while ((r = co_await parser.document()) == ParseResult::ok)
+//             use(consumer.root());
+//     }
+//     Task producer(AsyncParser<JsonConsumer>& parser, Socket& socket) {
+//         while (auto chunk = co_await socket.read())
+//             co_await parser.feed(*chunk);
+//         co_await parser.close();
+//     }
+//
+// The documents are concatenated, separated by whitespace or by nothing
+// when unambiguous, like Framing::concatenated of DocumentStream.
+//
+// feed() parses the chunk right away and resumes the waiting reader from
+// inside the call each time a document ends; the reader runs until it
+// awaits the next one. So the chunk has been consumed when feed() returns
+// and its buffer may be reused. feed() and close() never suspend: they
+// can be awaited or called from plain code, and any coroutine type works
+// for either side. Nothing is scheduled, synchronized or allocated, except
+// when no reader is waiting: what is left of the chunk is then copied to a
+// buffer (which keeps its capacity) until one asks for a document.
+template <typename Consumer>
+class AsyncParser {
+public:
+    class Document;
+
+    explicit AsyncParser(Consumer& consumer): consumer_(consumer), parser_(consumer) {}
+
+    AsyncParser(const AsyncParser&) = delete;
+    AsyncParser& operator=(const AsyncParser&) = delete;
+
+    // co_await: ok when the next document is in the consumer, error when it
+    // is malformed (the stream stops there: every later await returns error)
+    // and partial when the input was closed before another document began.
+    // A consumer with reset() is reset before each document.
+    Document document() { return Document(*this); }
+
+    // Gives chunk to the parse.
+    std::suspend_never feed(std::string_view chunk);
+    // The end of the input, which completes a last document waiting for its
+    // end (a number).
+    std::suspend_never close() {
+        closed_ = true;
+        return feed(" ");
+    }
+
+    class Document {
+    public:
+        bool await_ready() { return parser_.step(); }
+        void await_suspend(std::coroutine_handle<> reader) { parser_.reader_ = reader; }
+        ParseResult await_resume() {
+            parser_.ready_ = false;
+            return parser_.result_;
+        }
+
+    private:
+        friend class AsyncParser;
+        explicit Document(AsyncParser& parser): parser_(parser) {}
+        AsyncParser& parser_;
+    };
+
+private:
+    enum class Status {between, document, failed};
+
+    // Parses the pending input up to the end of the next document. Returns
+    // whether a result is ready.
+    bool step();
+
+    Consumer& consumer_;
+    typename detail::DocumentParser<Consumer>::type parser_;
+    Status status_ = Status::between;
+    const char* p_ = nullptr;           // the pending input, in the chunk or in buffer_
+    const char* end_ = nullptr;
+    std::string buffer_;
+    bool closed_ = false;
+    bool ready_ = false;                // result_ waits for the reader
+    ParseResult result_ = ParseResult::partial;
+    std::coroutine_handle<> reader_;    // waiting in document()
+};
+
+template <typename Consumer>
+std::suspend_never AsyncParser<Consumer>::feed(std::string_view chunk) {
+    if (status_ == Status::failed)
+        return {};
+    if (p_ != end_) {
+        // no reader since the last chunk: queue this one after it
+        const size_t consumed = static_cast<size_t>(p_ - buffer_.data());
+        buffer_.erase(0, consumed);
+        buffer_.append(chunk);
+    } else {
+        p_ = chunk.data();
+        end_ = p_ + chunk.size();
+        while (reader_ && step())
+            std::exchange(reader_, nullptr).resume();
+        if (p_ == end_)
+            return {};
+        buffer_.assign(p_, end_);
+    }
+    p_ = buffer_.data();
+    end_ = p_ + buffer_.size();
+    return {};
+}
+
+template <typename Consumer>
+bool AsyncParser<Consumer>::step() {
+    if (ready_)
+        return true;
+    if (status_ == Status::failed) {
+        result_ = ParseResult::error;
+        return ready_ = true;
+    }
+    while (p_ != end_) {
+        if (status_ == Status::between) {
+            p_ = simd::skip_whitespace(p_, end_);
+            if (p_ == end_)
+                break;
+#if __cpp_concepts
+            if constexpr (ResettableConsumerConcept<Consumer>)
+                consumer_.reset();
+#endif
+            parser_.reset();
+            status_ = Status::document;
+        }
+        const ParseResult r = parser_.parse(p_, end_);
+        if (r == ParseResult::partial)
+            break;
+        if (r == ParseResult::error) {
+            status_ = Status::failed;
+            p_ = end_;
+        } else {
+            status_ = Status::between;
+        }
+        result_ = r;
+        return ready_ = true;
+    }
+    if (!closed_)
+        return false;
+    if (status_ == Status::document)
+        status_ = Status::failed;
+    result_ = status_ == Status::failed ? ParseResult::error : ParseResult::partial;
+    return ready_ = true;
+}
+
+
+// A lazily started generator: the body runs up to each co_yield as the
+// range is iterated. Exceptions from the body are rethrown by the
+// iterator.
+template <typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T* value = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        iterator() = default;
+        const T& operator*() const { return *h_.promise().value; }
+        const T* operator->() const { return h_.promise().value; }
+        iterator& operator++() {
+            h_.resume();
+            rethrow();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !h_ || h_.done(); }
+
+    private:
+        friend class Generator;
+        explicit iterator(Handle h): h_(h) {}
+        void rethrow() {
+            if (h_.promise().error)
+                std::rethrow_exception(std::exchange(h_.promise().error, nullptr));
+        }
+        Handle h_;
+    };
+
+    Generator(Generator&& other) noexcept: h_(std::exchange(other.h_, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept {
+        std::swap(h_, other.h_);
+        return *this;
+    }
+    ~Generator() {
+        if (h_)
+            h_.destroy();
+    }
+
+    // once only
+    iterator begin() {
+        iterator it(h_);
+        ++it;
+        return it;
+    }
+    std::default_sentinel_t end() { return {}; }
+
+private:
+    explicit Generator(Handle h): h_(h) {}
+    Handle h_;
+};
+
+
+// One parse event of json_events(). text is the key or the string,
+// decoded, or the number as written; it is valid until the next event.
+struct JsonEvent {
+    enum class Type : uint8_t {object_begin, object_end, array_begin, array_end, key, string, number,
+        boolean, null, error};
+
+    Type type = Type::error;
+    std::string_view text = {};
+    bool boolean = false;
+};
+
+namespace detail {
+
+// The events of one chunk, their texts in one buffer: the storage is reused
+// from chunk to chunk.
+class EventQueue {
+public:
+    size_t size() const { return events_.size(); }
+    JsonEvent operator[](size_t i) const {
+        const Entry& e = events_[i];
+        return JsonEvent{e.type, std::string_view(text_).substr(e.offset, e.size), e.boolean};
+    }
+    // keeps the beginning of a string cut by the end of the chunk
+    void clear() {
+        events_.clear();
+        if (open_) {
+            text_.erase(0, begin_);
+            begin_ = 0;
+        } else {
+            text_.clear();
+        }
+    }
+
+    void string_begin() { open(); }
+    void add_char_string(char c) { text_.push_back(c); }
+    void add_chars_string(std::string_view s) { text_.append(s); }
+    void string_end() { add_text(JsonEvent::Type::string); }
+    void string_raw(std::string_view raw, bool escaped) { add_raw(JsonEvent::Type::string, raw, escaped); }
+
+    void key_begin() { open(); }
+    void add_char_key(char c) { text_.push_back(c); }
+    void add_chars_key(std::string_view s) { text_.append(s); }
+    void key_end() { add_text(JsonEvent::Type::key); }
+    void key_raw(std::string_view raw, bool escaped) { add_raw(JsonEvent::Type::key, raw, escaped); }
+
+    // numbers are kept as written
+    bool number_raw(std::string_view text) {
+        open();
+        text_.append(text);
+        add_text(JsonEvent::Type::number);
+        return true;
+    }
+    void number_value(int64_t) {}
+    void number_value(uint64_t) {}
+    void number_value(double) {}
+
+    void set_bool(bool v) { events_.push_back(Entry{JsonEvent::Type::boolean, 0, 0, v}); }
+    void set_null() { add(JsonEvent::Type::null); }
+
+    void object_begin() { add(JsonEvent::Type::object_begin); }
+    void object_end() { add(JsonEvent::Type::object_end); }
+    void array_begin() { add(JsonEvent::Type::array_begin); }
+    void array_end() { add(JsonEvent::Type::array_end); }
+
+    typedef EventQueue KeyConsumerType;
+    typedef EventQueue ValueConsumerType;
+    typedef EventQueue KeyValueConsumerType;
+    typedef EventQueue NumberConsumerType;
+    typedef EventQueue StringConsumerType;
+    typedef EventQueue ObjectConsumerType;
+    typedef EventQueue ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+
+private:
+    struct Entry {
+        JsonEvent::Type type;
+        size_t offset;
+        size_t size;
+        bool boolean;
+    };
+
+    void add(JsonEvent::Type type) { events_.push_back(Entry{type, 0, 0, false}); }
+    void open() {
+        begin_ = text_.size();
+        open_ = true;
+    }
+    void add_text(JsonEvent::Type type) {
+        events_.push_back(Entry{type, begin_, text_.size() - begin_, false});
+        open_ = false;
+    }
+    void add_raw(JsonEvent::Type type, std::string_view raw, bool escaped) {
+        open();
+        if (escaped) {
+            unescape(raw, decoded_);
+            raw = decoded_;
+        }
+        text_.append(raw);
+        add_text(type);
+    }
+
+    std::vector<Entry> events_;
+    std::string text_;
+    std::string decoded_;   // unescape() replaces what its output held
+    size_t begin_ = 0;      // of the text being gathered
+    bool open_ = false;
+};
+
+} // namespace detail
+
+// The events of the document in chunks, a range of anything convertible to
+// std::string_view, as they are parsed: each chunk is parsed when the
+// events of the previous one are exhausted. A malformed document (or
+// anything but whitespace after it) ends with an error event.
+template <typename Chunks>
+Generator<JsonEvent> json_events(Chunks chunks) {
+    detail::EventQueue queue;
+    ValueParser<detail::EventQueue> parser(queue);
+    ParseResult r = ParseResult::partial;
+    bool started = false;
+    for (const auto& c: chunks) {
+        const std::string_view chunk(c);
+        const char* p = chunk.data();
+        const char* end = p + chunk.size();
+        if (r == ParseResult::partial) {
+            if (!started)
+                p = simd::skip_whitespace(p, end);
+            if (p != end) {
+                started = true;
+                r = parser.parse(p, end);
+            }
+            for (size_t i = 0; i < queue.size(); ++i)
+                co_yield queue[i];
+            queue.clear();
+        }
+        if (r == ParseResult::error || (r == ParseResult::ok && simd::skip_whitespace(p, end) != end)) {
+            co_yield JsonEvent{JsonEvent::Type::error};
+            co_return;
+        }
+    }
+    if (r == ParseResult::partial && started) {
+        // a number at the end of the input
+        const char* space = " ";
+        r = parser.parse(space, space + 1);
+        for (size_t i = 0; i < queue.size(); ++i)
+            co_yield queue[i];
+    }
+    if (r != ParseResult::ok)
+        co_yield JsonEvent{JsonEvent::Type::error};
+}
+
+} // namespace libacpp::json
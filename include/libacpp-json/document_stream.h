@@ -0,0 +1,108 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstdint>
+
+#include "parser.h"
+#include "stack_parser.h"
+
+namespace libacpp::json {
+
+#if __cpp_concepts
+
+// Optional hooks of the handler of a DocumentStream, each one on its own.
+template <typename T>
+concept DocumentBeginHandlerConcept = requires(T t) {
+    t.document_begin();
+};
+
+template <typename T>
+concept DocumentEndHandlerConcept = requires(T t) {
+    t.document_end();
+};
+
+// offset: position in the stream of the byte where the record failed
+template <typename T>
+concept DocumentErrorHandlerConcept = requires(T t, uint64_t offset) {
+    t.document_error(offset);
+};
+
+// Consumers with reset() are reset before each document, so that it starts
+// from a clean consumer even after a malformed record.
+template <typename T>
+concept ResettableConsumerConcept = requires(T t) {
+    t.reset();
+};
+
+#endif
+
+// lines: JSON Lines / NDJSON, one document per line; a line break inside a
+// document ends the record and makes it malformed, and so does anything but
+// whitespace after the document on its line. document_end() comes once the
+// whole line has been seen.
+// concatenated: documents one after the other, separated by whitespace or
+// by nothing when unambiguous ({}{}, [1]"a").
+enum class Framing {lines, concatenated};
+
+// Parses a stream of top-level documents given in chunks cut anywhere.
+// Each document goes to the consumer; the handler hears where documents
+// begin and end (document_end() is the time to take the value a
+// JsonConsumer built: the next document resets it). The parser and its
+// stack are kept from one document to the next.
+//
+// A malformed record does not stop the stream: the handler gets
+// document_error() and the input is skipped up to the next line break,
+// found with a vectorized scan; parsing resumes there.
+template<typename Consumer, typename Handler = Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+class DocumentStream {
+public:
+    DocumentStream(Consumer& consumer, Handler& handler, Framing framing = Framing::lines,
+        size_t max_depth = StackParser<Consumer>::default_max_depth);
+    // the consumer is its own handler
+    explicit DocumentStream(Consumer& consumer, Framing framing = Framing::lines,
+        size_t max_depth = StackParser<Consumer>::default_max_depth)
+    :DocumentStream(consumer, consumer, framing, max_depth) {}
+
+    // Parses the chunk [p, end), all of it: returns partial, more input is
+    // always welcome.
+    ParseResult parse(const char*& p, const char* end);
+    // The end of the stream: completes a last document that was waiting for
+    // its end (a number). Returns error when the stream ends inside a
+    // document, which is then counted as malformed, and ok otherwise.
+    ParseResult finish();
+    // Forgets the document in progress and the counters.
+    void reset();
+
+    uint64_t documents() const { return documents_; }
+    // malformed records skipped
+    uint64_t errors() const { return errors_; }
+    // bytes of the stream parsed so far
+    uint64_t offset() const { return offset_; }
+
+private:
+    // line_end: the document of a line is parsed, its line break is not
+    enum class Status {between, document, line_end, skip};
+
+    void begin_document();
+    void end_document();
+    void fail(uint64_t offset, Status next);
+
+    Status status_ = Status::between;
+    Framing framing_;
+    uint64_t documents_ = 0;
+    uint64_t errors_ = 0;
+    uint64_t offset_ = 0;
+    StackParser<Consumer> parser_;
+    Consumer& consumer_;
+    Handler& handler_;
+};
+
+} // namespace libacpp::json
+
+#include "document_stream.inl"
@@ -0,0 +1,145 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+namespace libacpp::json {
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+DocumentStream<Consumer, Handler>::DocumentStream(Consumer& consumer, Handler& handler, Framing framing,
+    size_t max_depth)
+:framing_(framing), parser_(consumer, max_depth), consumer_(consumer), handler_(handler) {}
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+void DocumentStream<Consumer, Handler>::reset() {
+    status_ = Status::between;
+    documents_ = 0;
+    errors_ = 0;
+    offset_ = 0;
+    parser_.reset();
+}
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+void DocumentStream<Consumer, Handler>::begin_document() {
+    status_ = Status::document;
+    if constexpr (ResettableConsumerConcept<Consumer>)
+        consumer_.reset();
+    if constexpr (DocumentBeginHandlerConcept<Handler>)
+        handler_.document_begin();
+}
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+void DocumentStream<Consumer, Handler>::end_document() {
+    status_ = Status::between;
+    parser_.reset();
+    ++documents_;
+    if constexpr (DocumentEndHandlerConcept<Handler>)
+        handler_.document_end();
+}
+
+// next: skip when the rest of the record is still ahead, between when the
+// line break that ended it has been consumed
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+void DocumentStream<Consumer, Handler>::fail(uint64_t offset, Status next) {
+    status_ = next;
+    parser_.reset();
+    ++errors_;
+    if constexpr (DocumentErrorHandlerConcept<Handler>)
+        handler_.document_error(offset);
+}
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult DocumentStream<Consumer, Handler>::parse(const char*& p, const char* end) {
+    const char* const begin = p;
+    while (p != end) {
+        if (status_ == Status::line_end) {
+            // the rest of the record must be blank for the document to count
+            const char* nl = simd::find_newline(p, end);
+            const char* q = simd::skip_whitespace(p, nl);
+            if (q != nl) {
+                fail(offset_ + (q - begin), Status::skip);
+                p = q;
+                continue;
+            }
+            if (nl == end) {
+                p = end;
+                break;
+            }
+            p = nl + 1;
+            end_document();
+            continue;
+        }
+        if (status_ == Status::skip) {
+            const char* nl = simd::find_newline(p, end);
+            if (nl == end) {
+                p = end;
+                break;
+            }
+            p = nl + 1;
+            status_ = Status::between;
+            continue;
+        }
+        if (status_ == Status::between) {
+            p = simd::skip_whitespace(p, end);
+            if (p == end)
+                break;
+            begin_document();
+        }
+        // a line is fed with its line break, which may end a number
+        const char* limit = end;
+        if (framing_ == Framing::lines) {
+            const char* nl = simd::find_newline(p, end);
+            if (nl != end)
+                limit = nl + 1;
+        }
+        switch (parser_.parse(p, limit)) {
+            case ParseResult::ok:
+                if (framing_ == Framing::lines)
+                    status_ = Status::line_end;
+                else
+                    end_document();
+                break;
+            case ParseResult::error:
+                fail(offset_ + (p - begin), Status::skip);
+                break;
+            case ParseResult::partial:
+                // the parser has taken everything up to limit
+                if (framing_ == Framing::lines && p != begin && p[-1] == '\n')
+                    fail(offset_ + (p - begin) - 1, Status::between);
+                break;
+        }
+    }
+    offset_ += p - begin;
+    return ParseResult::partial;
+}
+
+template<typename Consumer, typename Handler>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult DocumentStream<Consumer, Handler>::finish() {
+    if (status_ == Status::line_end) {
+        end_document();
+        return ParseResult::ok;
+    }
+    if (status_ != Status::document) {
+        status_ = Status::between;
+        return ParseResult::ok;
+    }
+    // a top-level number ends at the byte after it: give it one
+    static constexpr char terminator[] = " ";
+    const char* p = terminator;
+    if (parser_.parse(p, terminator + 1) == ParseResult::ok) {
+        end_document();
+        return ParseResult::ok;
+    }
+    fail(offset_, Status::between);
+    return ParseResult::error;
+}
+
+} // namespace libacpp::json
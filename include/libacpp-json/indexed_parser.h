@@ -0,0 +1,74 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <vector>
+
+#include "parser.h"
+#include "stack_parser.h"
+#include "structural.h"
+
+namespace libacpp::json {
+
+// Two stage parser for documents held whole in memory. Stage 1 indexes the
+// structural positions of the buffer with SIMD (StructuralIndex); stage 2
+// walks that index, so whitespace and string contents are never visited
+// byte by byte between tokens. Scalars are handed to the same leaf parsers
+// as the chunked engines and the consumers are the ones StackParser
+// accepts.
+//
+// parse() returns ok for a complete document, partial when the buffer ends
+// before the document does (to be parsed again with more input) and error
+// otherwise. Trailing content after the document is an error.
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+class IndexedParser {
+public:
+    static constexpr size_t default_max_depth = StackParser<Consumer>::default_max_depth;
+
+    IndexedParser(Consumer& consumer, size_t max_depth = default_max_depth);
+    ParseResult parse(const char* begin, const char* end);
+
+    const StructuralIndex& index() const { return index_; }
+
+private:
+    using ObjectConsumer = typename Consumer::ObjectConsumerType;
+    using KeyValueConsumer = typename ObjectConsumer::KeyValueConsumerType;
+    using ArrayConsumer = typename Consumer::ArrayConsumerType;
+
+    using KeyParser = StringParser<typename KeyValueConsumer::KeyConsumerType, true>;
+    using StringValueParser = StringParser<typename Consumer::StringConsumerType, false>;
+    using NumberValueParser = NumberParser<typename Consumer::NumberConsumerType>;
+
+    enum class Status {value, object_first, key, object_next, array_first, array_next, done};
+
+    // one nesting level: exactly one of the two pointers is set
+    struct Frame {
+        ObjectConsumer* object;
+        ArrayConsumer* array;
+    };
+
+    ParseResult run(const char* begin, const char* end);
+    Consumer& value_consumer();
+    ParseResult value(const uint32_t*& pos);
+    bool scalar_end(const char* p, const uint32_t* pos);
+    void close();
+    void end_value();
+
+    Status status_;
+    size_t max_depth_;
+    std::vector<Frame> stack_;
+    StructuralIndex index_;
+    const char* begin_ = nullptr;
+    const char* end_ = nullptr;
+    Consumer& consumer_;
+};
+
+} // namespace libacpp::json
+
+
+#include "indexed_parser.inl"
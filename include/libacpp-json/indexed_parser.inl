@@ -0,0 +1,232 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+namespace libacpp::json {
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+IndexedParser<Consumer>::IndexedParser(Consumer& consumer, size_t max_depth)
+:status_(Status::value), max_depth_(max_depth), consumer_(consumer) {
+    stack_.reserve(max_depth_);
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+Consumer& IndexedParser<Consumer>::value_consumer() {
+    if (stack_.empty())
+        return consumer_;
+    const Frame& top = stack_.back();
+    if (top.object) {
+        KeyValueConsumer& kv = *top.object;
+        return kv.value_consumer();
+    }
+    return top.array->value_consumer();
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+void IndexedParser<Consumer>::end_value() {
+    if (stack_.empty())
+        status_ = Status::done;
+    else if (stack_.back().object)
+        status_ = Status::object_next;
+    else
+        status_ = Status::array_next;
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+void IndexedParser<Consumer>::close() {
+    Frame top = stack_.back();
+    stack_.pop_back();
+    if (top.object)
+        top.object->object_end();
+    else
+        top.array->array_end();
+    JSON_TRACE_EVENT(container_end);
+    end_value();
+}
+
+// A scalar must be followed by nothing but whitespace up to the next
+// structural position (or the end of the buffer).
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+bool IndexedParser<Consumer>::scalar_end(const char* p, const uint32_t* pos) {
+    const char* next = begin_ + *pos;
+    return p == next || simd::skip_whitespace(p, next) == next;
+}
+
+// The value at *pos: containers are opened, scalars are parsed whole.
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult IndexedParser<Consumer>::value(const uint32_t*& pos) {
+    const char* p = begin_ + *pos;
+    Consumer& consumer = value_consumer();
+    ParseResult r;
+    switch (value_start(*p)) {
+        case ValueStart::object: {
+            if (stack_.size() == max_depth_)
+                return ParseResult::error;
+            ObjectConsumer& object = consumer.object_consumer();
+            stack_.push_back(Frame{&object, nullptr});
+            object.object_begin();
+            JSON_TRACE_EVENT(container_begin);
+            status_ = Status::object_first;
+            ++pos;
+            return ParseResult::ok;
+        }
+        case ValueStart::array: {
+            if (stack_.size() == max_depth_)
+                return ParseResult::error;
+            ArrayConsumer& array = consumer.array_consumer();
+            stack_.push_back(Frame{nullptr, &array});
+            array.array_begin();
+            JSON_TRACE_EVENT(container_begin);
+            status_ = Status::array_first;
+            ++pos;
+            return ParseResult::ok;
+        }
+        case ValueStart::string: {
+            StringValueParser sp(consumer.string_consumer());
+            r = sp.parse(p, end_);
+            break;
+        }
+        case ValueStart::number: {
+            NumberValueParser np(consumer.number_consumer());
+            r = np.parse(p, end_);
+            if (r == ParseResult::partial)
+                r = np.finish();
+            break;
+        }
+        case ValueStart::null_val:
+            r = NullParser().parse(p, end_);
+            if (r == ParseResult::ok)
+                consumer.set_null();
+            break;
+        case ValueStart::true_val:
+            r = TrueParser().parse(p, end_);
+            if (r == ParseResult::ok)
+                consumer.set_bool(true);
+            break;
+        case ValueStart::false_val:
+            r = FalseParser().parse(p, end_);
+            if (r == ParseResult::ok)
+                consumer.set_bool(false);
+            break;
+        default:
+            return ParseResult::error;
+    }
+    if (r != ParseResult::ok)
+        return r;
+    ++pos;
+    if (!scalar_end(p, pos))
+        return ParseResult::error;
+    end_value();
+    return ParseResult::ok;
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult IndexedParser<Consumer>::parse(const char* begin, const char* end) {
+    JSON_TRACE_SCOPE(begin);
+    ParseResult r = run(begin, end);
+    // a partial document is parsed again from its beginning
+    return JSON_TRACE_RESULT(r, r == ParseResult::ok ? end : begin);
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult IndexedParser<Consumer>::run(const char* begin, const char* end) {
+    begin_ = begin;
+    end_ = end;
+    status_ = Status::value;
+    stack_.clear();
+    switch (index_.build(begin, end)) {
+        case StructuralIndex::Result::ok:
+            break;
+        case StructuralIndex::Result::open_string:
+            return ParseResult::partial;
+        case StructuralIndex::Result::too_large:
+            return ParseResult::error;
+    }
+
+    const uint32_t* pos = index_.begin();
+    const uint32_t* last = index_.end() - 1; // the sentinel
+    while (pos != last) {
+        const char c = begin_[*pos];
+        ParseResult r = ParseResult::ok;
+        switch (status_) {
+            case Status::value:
+                r = value(pos);
+                break;
+            case Status::object_first:
+                if (c == '}') {
+                    ++pos;
+                    close();
+                } else {
+                    status_ = Status::key;
+                }
+                break;
+            case Status::key: {
+                if (c != '"')
+                    return ParseResult::error;
+                KeyValueConsumer& kv = *stack_.back().object;
+                KeyParser kp(kv.key_consumer(), true);
+                const char* p = begin_ + *pos;
+                r = kp.parse(p, end_);
+                if (r != ParseResult::ok)
+                    return r;
+                ++pos;
+                if (!scalar_end(p, pos))
+                    return ParseResult::error;
+                if (pos == last)
+                    return ParseResult::partial;
+                if (begin_[*pos] != ':')
+                    return ParseResult::error;
+                ++pos;
+                status_ = Status::value;
+                break;
+            }
+            case Status::object_next:
+                if (c == ',') {
+                    ++pos;
+                    status_ = Status::key;
+                } else if (c == '}') {
+                    ++pos;
+                    close();
+                } else {
+                    return ParseResult::error;
+                }
+                break;
+            case Status::array_first:
+                if (c == ']') {
+                    ++pos;
+                    close();
+                } else {
+                    status_ = Status::value;
+                }
+                break;
+            case Status::array_next:
+                if (c == ',') {
+                    ++pos;
+                    status_ = Status::value;
+                } else if (c == ']') {
+                    ++pos;
+                    close();
+                } else {
+                    return ParseResult::error;
+                }
+                break;
+            case Status::done:
+                return ParseResult::error; // trailing content
+        }
+        if (r != ParseResult::ok)
+            return r;
+    }
+    return status_ == Status::done ? ParseResult::ok : ParseResult::partial;
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,108 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace libacpp::json {
+
+// Object keys seen across documents, each stored once. A stream that
+// repeats the same few hundred keys interns them on the first documents;
+// from then on a key costs one hash lookup and no allocation, and keys from
+// the same table compare by address.
+//
+// Symbols are never removed or moved, so documents may keep pointers to
+// them for as long as the table lives. The table is not synchronized: use
+// one per thread (a thread_local one serves every consumer of the thread).
+// Once max_size keys are known, new keys are not added and intern()
+// returns nullptr, so a stream of unbounded distinct keys cannot make it
+// grow without limit.
+class KeyTable {
+public:
+    struct Symbol {
+        std::string name;
+        size_t hash;
+        uint32_t id;            // 0 .. size() - 1, in order of interning
+        const KeyTable* table;
+    };
+
+    static constexpr size_t default_max_size = 1 << 16;
+
+    explicit KeyTable(size_t max_size = default_max_size): max_size_(max_size) {}
+
+    KeyTable(const KeyTable&) = delete;
+    KeyTable& operator=(const KeyTable&) = delete;
+
+    // the symbol of key, added the first time it is seen; nullptr when the
+    // key is new and the table is full
+    const Symbol* intern(std::string_view key);
+    // the symbol of key, nullptr when it has not been interned
+    const Symbol* find(std::string_view key) const;
+    const Symbol& symbol(uint32_t id) const { return symbols_[id]; }
+
+    size_t size() const { return symbols_.size(); }
+    size_t max_size() const { return max_size_; }
+
+private:
+    size_t max_size_;
+    std::deque<Symbol> symbols_;
+    std::unordered_map<std::string_view, const Symbol*> index_;
+};
+
+// The key of an object member: either a symbol of a KeyTable, which costs
+// nothing to store, or an owned string allocated like the rest of the
+// document. Two interned keys of the same table compare as pointers.
+class JsonKey {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    JsonKey() = default;
+    explicit JsonKey(const allocator_type& alloc): owned_(alloc) {}
+    explicit JsonKey(std::string_view key, const allocator_type& alloc = {}): owned_(key, alloc) {}
+    explicit JsonKey(std::pmr::string&& key): owned_(std::move(key)) {}
+    explicit JsonKey(const KeyTable::Symbol& symbol, const allocator_type& alloc = {})
+    :owned_(alloc), symbol_(&symbol) {}
+
+    JsonKey(const JsonKey& other) = default;
+    JsonKey(JsonKey&& other) = default;
+    JsonKey(const JsonKey& other, const allocator_type& alloc): owned_(other.owned_, alloc), symbol_(other.symbol_) {}
+    JsonKey(JsonKey&& other, const allocator_type& alloc)
+    :owned_(std::move(other.owned_), alloc), symbol_(other.symbol_) {}
+    JsonKey& operator=(const JsonKey& other) = default;
+    JsonKey& operator=(JsonKey&& other) = default;
+
+    allocator_type get_allocator() const { return owned_.get_allocator(); }
+
+    std::string_view view() const { return symbol_ ? std::string_view(symbol_->name) : std::string_view(owned_); }
+    operator std::string_view() const { return view(); }
+    // nullptr for owned keys
+    const KeyTable::Symbol* symbol() const { return symbol_; }
+    size_t hash() const { return symbol_ ? symbol_->hash : std::hash<std::string_view>{}(owned_); }
+
+    bool operator==(const JsonKey& other) const {
+        if (symbol_ && other.symbol_ && symbol_->table == other.symbol_->table)
+            return symbol_ == other.symbol_;
+        return view() == other.view();
+    }
+    bool operator==(std::string_view other) const { return view() == other; }
+
+    friend std::ostream& operator<<(std::ostream& os, const JsonKey& key) { return os << key.view(); }
+
+private:
+    std::pmr::string owned_;
+    const KeyTable::Symbol* symbol_ = nullptr;
+};
+
+} // namespace libacpp::json
@@ -0,0 +1,61 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Building blocks of the NumberParser value mode.
+namespace libacpp::json::number {
+
+// SWAR helpers over 8 ASCII bytes loaded as a little endian word.
+inline bool is_8_digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ull)
+        | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+inline uint32_t parse_8_digits(uint64_t v) {
+    const uint64_t mask = 0x000000FF000000FFull;
+    const uint64_t mul1 = 0x000F424000000064ull; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8); // pairs of digits
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(v);
+}
+
+// Appends the run of digits at p to mantissa, 8 at a time while they are
+// contiguous. Wraps on overflow: callers count the digits themselves.
+inline const char* parse_digits(const char* p, const char* end, uint64_t& mantissa) {
+    if constexpr (std::endian::native == std::endian::little) {
+        while (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if (!is_8_digits(word))
+                break;
+            mantissa = mantissa * 100000000 + parse_8_digits(word);
+            p += 8;
+        }
+    }
+    while (p != end && '0' <= *p && *p <= '9') {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+
+// Correctly rounded (-1)^negative * mantissa * 10^exponent, using Clinger's
+// fast path and then the Eisel-Lemire algorithm. Returns false in the rare
+// cases neither can decide; the caller then falls back to parse_double().
+bool compute_double(uint64_t mantissa, int64_t exponent, bool negative, double& result);
+
+// Slow path: full decimal to binary conversion of a JSON number text.
+double parse_double(std::string_view text);
+
+} // namespace libacpp::json::number
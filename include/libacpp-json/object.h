@@ -0,0 +1,162 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "key_table.h"
+
+namespace libacpp::json {
+
+// The members of an object in document order, in one contiguous vector of
+// key/value pairs. Small objects are searched linearly, which beats any
+// tree or hash for a handful of short keys; past hash_threshold members an
+// open addressing index of the positions is built and kept up to date.
+// Keys are unique: inserting an existing key finds the member instead.
+// Keys are JsonKey: interned keys are found comparing addresses and hashed
+// with the hash kept in their symbol.
+//
+// Value may be incomplete where the object is declared, as JsonValue is
+// inside its own variant.
+template <typename Value>
+class OrderedObject {
+public:
+    using key_type = JsonKey;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, Value>;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+    using iterator = typename std::pmr::vector<value_type>::iterator;
+    using const_iterator = typename std::pmr::vector<value_type>::const_iterator;
+
+    static constexpr size_t hash_threshold = 16;
+
+    OrderedObject() = default;
+    explicit OrderedObject(const allocator_type& alloc): members_(alloc), index_(alloc) {}
+
+    allocator_type get_allocator() const { return members_.get_allocator(); }
+
+    iterator begin() { return members_.begin(); }
+    iterator end() { return members_.end(); }
+    const_iterator begin() const { return members_.begin(); }
+    const_iterator end() const { return members_.end(); }
+    size_t size() const { return members_.size(); }
+    bool empty() const { return members_.empty(); }
+    void reserve(size_t n) { members_.reserve(n); }
+    void clear() { members_.clear(); index_.clear(); }
+
+    iterator find(std::string_view key) { return begin() + position(key); }
+    const_iterator find(std::string_view key) const { return begin() + position(key); }
+    iterator find(const key_type& key) { return begin() + position(key); }
+    const_iterator find(const key_type& key) const { return begin() + position(key); }
+    bool contains(std::string_view key) const { return position(key) != size(); }
+    // with the hash of key already known (std::hash<std::string_view>), as
+    // a compiled JsonPath keeps it
+    const_iterator find(std::string_view key, size_t key_hash) const { return begin() + position(key, key_hash); }
+
+    Value& at(std::string_view key) {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("JsonObject::at: no such key");
+        return it->second;
+    }
+    const Value& at(std::string_view key) const { return const_cast<OrderedObject&>(*this).at(key); }
+
+    Value& operator[](std::string_view key) { return try_emplace(key).first->second; }
+
+    // Appends key with a value built from args unless the key is there.
+    // Key is a key_type or anything that converts to a std::string_view; it
+    // is copied only when it is added.
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        if constexpr (std::is_same_v<Key, key_type>)
+            return emplace_member(key, std::forward<Args>(args)...);
+        else
+            return emplace_member(std::string_view(key), std::forward<Args>(args)...);
+    }
+
+    // The same, moving the key in: a key built with the object's resource
+    // is taken over without copying its bytes.
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return emplace_member(std::move(key), std::forward<Args>(args)...);
+    }
+
+private:
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> emplace_member(Key&& key, Args&&... args) {
+        size_t pos = position(key);
+        if (pos != size())
+            return {begin() + pos, false};
+        // the key gets the object's resource through uses-allocator construction
+        members_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        index_member(size() - 1);
+        return {end() - 1, true};
+    }
+
+    static size_t hash(std::string_view key) { return std::hash<std::string_view>{}(key); }
+    static size_t hash(const key_type& key) { return key.hash(); }
+
+    // position of key, size() when missing
+    template <typename Key>
+    size_t position(const Key& key) const {
+        return position(key, index_.empty() ? 0 : hash(key));
+    }
+
+    template <typename Key>
+    size_t position(const Key& key, size_t key_hash) const {
+        if (index_.empty()) {
+            for (size_t i = 0; i < members_.size(); ++i) {
+                if (members_[i].first == key)
+                    return i;
+            }
+            return members_.size();
+        }
+        const size_t mask = index_.size() - 1;
+        for (size_t slot = key_hash & mask; index_[slot] != 0; slot = (slot + 1) & mask) {
+            const size_t i = index_[slot] - 1;
+            if (members_[i].first == key)
+                return i;
+        }
+        return members_.size();
+    }
+
+    // keeps the index (slots hold position + 1, 0 is empty) at most half full
+    void index_member(size_t i) {
+        if (members_.size() <= hash_threshold)
+            return;
+        if (members_.size() * 2 > index_.size()) {
+            index_.assign(std::max<size_t>(index_.size() * 2, 4 * hash_threshold), 0);
+            for (size_t j = 0; j < members_.size(); ++j)
+                insert_index(j);
+        } else {
+            insert_index(i);
+        }
+    }
+
+    void insert_index(size_t i) {
+        const size_t mask = index_.size() - 1;
+        size_t slot = hash(members_[i].first) & mask;
+        while (index_[slot] != 0)
+            slot = (slot + 1) & mask;
+        index_[slot] = static_cast<uint32_t>(i + 1);
+    }
+
+    std::pmr::vector<value_type> members_;
+    std::pmr::vector<uint32_t> index_;
+};
+
+} // namespace libacpp::json
@@ -0,0 +1,290 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "parse_result.h"
+
+namespace libacpp::json {
+
+class JsonConsumer;
+
+struct ParallelOptions {
+    size_t threads = 0;             // 0: std::thread::hardware_concurrency()
+    size_t slice_size = 1 << 20;    // bytes per task, extended to the next line break
+    // Results delivered in the order of the slices. Otherwise each one is
+    // delivered as soon as it is ready.
+    bool ordered = true;
+    // Slices parsed ahead of the next one to deliver, when ordered; it
+    // bounds the results held in memory. 0: 4 per thread.
+    size_t window = 0;
+};
+
+// Splits a buffer of JSON Lines at line breaks into slices of about
+// slice_size bytes, so every record lies within one slice.
+std::vector<std::string_view> split_lines(std::string_view lines, size_t slice_size);
+
+struct ParallelArrayResult {
+    ParseResult result = ParseResult::ok;   // ok or error, the document is whole
+    size_t ranges = 0;          // element ranges parsed on the threads and kept
+    bool sequential = false;    // some elements were parsed again on the calling thread
+};
+
+// Parses a document that is one large array, json, into consumer, its
+// elements on several threads. Split points are guessed every
+// options.slice_size bytes: a comma between a byte that can end an element
+// and one that can start the next, like the first element ("},{" for an
+// array of objects), not after an escaped quote. Each range of elements
+// between two guesses is parsed into an array of its own by a JsonConsumer
+// of its thread, with the string and number settings of consumer, and
+// counts only when it ends exactly at the next guess.
+//
+// The ranges are then moved into the array of consumer in order. A guess
+// that was not a split (a comma inside a string or a nested container)
+// makes its range fail; from there the elements are parsed on the calling
+// thread, up to the next guess the parse reaches exactly, whose range is
+// used again. The result is always that of a sequential parse: documents
+// that are not an array, small ones and consumers with an arena (the
+// threads cannot allocate from it) are parsed sequentially all along.
+//
+// Keys are not interned in the ranges parsed by the threads. Of the
+// options, only threads and slice_size apply.
+ParallelArrayResult parse_array_parallel(std::string_view json, JsonConsumer& consumer, ParallelOptions options = {});
+
+// Parses JSON Lines on several threads. The buffer is split at line
+// breaks and the slices are handed out to the threads as they become free,
+// so a slow slice does not hold the others back. The threads are started
+// by the constructor and wait between calls to parse(); each one has its
+// own Worker, kept between calls too:
+//
+//     struct Worker {
+//         Result parse(std::string_view slice);
+//     };
+//
+// usually a consumer with a DocumentStream over it that collects what the
+// caller needs from each document. The Result of each slice is given to
+// deliver(slice_index, Result&&) on the calling thread, in slice order when
+// options.ordered (holding at most options.window results), or as soon as
+// it is ready otherwise (from the worker threads, one call at a time).
+//
+// An exception thrown by a worker or by deliver stops the other threads
+// and is rethrown by parse(). One parse() runs at a time.
+template <typename Worker>
+class ParallelLineParser {
+public:
+    using Result = decltype(std::declval<Worker&>().parse(std::string_view()));
+
+    explicit ParallelLineParser(ParallelOptions options = {});
+    ~ParallelLineParser() { stop(); }
+
+    ParallelLineParser(const ParallelLineParser&) = delete;
+    ParallelLineParser& operator=(const ParallelLineParser&) = delete;
+
+    size_t threads() const { return options_.threads; }
+    Worker& worker(size_t i) { return *workers_[i]; }
+
+    // Returns the number of slices.
+    template <typename Deliver>
+    size_t parse(std::string_view lines, Deliver&& deliver);
+
+private:
+    // one result waiting for its delivery
+    struct Slot {
+        std::optional<Result> result;
+        std::atomic<size_t> slice{0};   // the slice + 1 of result, 0 while empty
+    };
+
+    // the loop of thread i: waits for a parse(), takes part in it
+    void thread_main(size_t i);
+    // ends and joins the threads
+    void stop();
+    template <typename Deliver>
+    void run(Worker& worker, Deliver& deliver);
+    // Blocks until ready() holds or the parse fails. Every change the
+    // threads wait for bumps progress_, so waiting on it cannot miss one.
+    template <typename Ready>
+    void wait(Ready ready);
+    void advance() {
+        progress_.fetch_add(1, std::memory_order_release);
+        progress_.notify_all();
+    }
+    void fail(std::exception_ptr error);
+
+    ParallelOptions options_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // the pool: each parse() bumps generation_ to wake the threads, which
+    // bump finished_ once they are done with it
+    std::vector<std::thread> threads_;
+    std::function<void(size_t)> job_;       // run by the threads below active_
+    size_t active_ = 0;
+    bool stopping_ = false;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<size_t> finished_{0};
+
+    // the state of a parse()
+    std::vector<std::string_view> slices_;
+    std::atomic<size_t> next_{0};           // the next slice to parse
+    std::atomic<size_t> delivered_{0};      // slices delivered, when ordered
+    std::atomic<bool> failed_{false};
+    std::atomic<uint64_t> progress_{0};
+    std::mutex mutex_;                      // error_, and deliver when unordered
+    std::exception_ptr error_;
+    std::unique_ptr<Slot[]> window_;
+};
+
+template <typename Worker>
+ParallelLineParser<Worker>::ParallelLineParser(ParallelOptions options): options_(options) {
+    if (options_.threads == 0)
+        options_.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (options_.window == 0)
+        options_.window = 4 * options_.threads;
+    for (size_t i = 0; i < options_.threads; ++i)
+        workers_.push_back(std::make_unique<Worker>());
+    threads_.reserve(options_.threads);
+    try {
+        for (size_t i = 0; i < options_.threads; ++i)
+            threads_.emplace_back([this, i]() { thread_main(i); });
+    } catch (...) {
+        // the destructor does not run: join the threads already started
+        stop();
+        throw;
+    }
+}
+
+template <typename Worker>
+void ParallelLineParser<Worker>::thread_main(size_t i) {
+    uint64_t seen = 0;
+    while (true) {
+        generation_.wait(seen, std::memory_order_acquire);
+        seen = generation_.load(std::memory_order_acquire);
+        if (stopping_)
+            return;
+        if (i < active_)
+            job_(i);
+        finished_.fetch_add(1, std::memory_order_release);
+        finished_.notify_all();
+    }
+}
+
+template <typename Worker>
+void ParallelLineParser<Worker>::stop() {
+    stopping_ = true;
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_all();
+    for (std::thread& t: threads_)
+        t.join();
+    threads_.clear();
+}
+
+template <typename Worker>
+template <typename Deliver>
+size_t ParallelLineParser<Worker>::parse(std::string_view lines, Deliver&& deliver) {
+    slices_ = split_lines(lines, options_.slice_size);
+    next_ = 0;
+    delivered_ = 0;
+    failed_ = false;
+    error_ = nullptr;
+    if (options_.ordered)
+        window_ = std::make_unique<Slot[]>(options_.window);
+
+    job_ = [this, &deliver](size_t i) { run(*workers_[i], deliver); };
+    active_ = std::min(options_.threads, slices_.size());
+    finished_.store(0, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_all();
+
+    if (options_.ordered) {
+        try {
+            for (size_t i = 0; i < slices_.size(); ++i) {
+                Slot& slot = window_[i % options_.window];
+                wait([&]() { return slot.slice.load(std::memory_order_acquire) == i + 1; });
+                if (failed_)
+                    break;
+                Result result = std::move(*slot.result);
+                slot.result.reset();
+                slot.slice.store(0, std::memory_order_relaxed);
+                delivered_.store(i + 1, std::memory_order_release);
+                advance();
+                deliver(i, std::move(result));
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    }
+    for (size_t finished; (finished = finished_.load(std::memory_order_acquire)) != threads_.size();)
+        finished_.wait(finished, std::memory_order_acquire);
+    job_ = nullptr;
+    window_.reset();
+    if (error_)
+        std::rethrow_exception(error_);
+    return slices_.size();
+}
+
+template <typename Worker>
+template <typename Deliver>
+void ParallelLineParser<Worker>::run(Worker& worker, Deliver& deliver) {
+    try {
+        for (size_t i = next_++; i < slices_.size() && !failed_; i = next_++) {
+            if (options_.ordered) {
+                // slices are taken in order, so the one to deliver next is
+                // never kept waiting here
+                wait([&]() { return i < delivered_.load(std::memory_order_acquire) + options_.window; });
+                if (failed_)
+                    break;
+                Slot& slot = window_[i % options_.window];
+                slot.result.emplace(worker.parse(slices_[i]));
+                slot.slice.store(i + 1, std::memory_order_release);
+                advance();
+            } else {
+                Result result = worker.parse(slices_[i]);
+                std::lock_guard lock(mutex_);
+                if (!failed_)
+                    deliver(i, std::move(result));
+            }
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+}
+
+template <typename Worker>
+template <typename Ready>
+void ParallelLineParser<Worker>::wait(Ready ready) {
+    while (true) {
+        const uint64_t progress = progress_.load(std::memory_order_acquire);
+        if (ready() || failed_)
+            return;
+        progress_.wait(progress, std::memory_order_acquire);
+    }
+}
+
+template <typename Worker>
+void ParallelLineParser<Worker>::fail(std::exception_ptr error) {
+    {
+        std::lock_guard lock(mutex_);
+        if (!error_)
+            error_ = error;
+    }
+    failed_ = true;
+    advance();
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,15 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+namespace libacpp::json {
+
+// What a parse call returns: a complete value, more input needed, or
+// malformed input.
+enum class ParseResult {ok, partial, error};
+
+} // namespace libacpp::json
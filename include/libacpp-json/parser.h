@@ -5,14 +5,21 @@
 //          https://www.mozilla.org/en-US/MPL/2.0/)
 
 #pragma once
-//TODO: REMOVE this
-#include <iostream>
 
-#include "log.h"
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
-namespace libacpp::json {
+#include "parse_result.h"
+#include "reflection.h"
+#include "simd.h"
+#include "trace.h"
 
-enum class ParseResult {ok, partial, error};
+namespace libacpp::json {
 
 std::string to_string(ParseResult r);
 
@@ -44,17 +51,65 @@ concept StringConsumerConcept =
         t.string_end();    
     } && (!is_key));
 
+// Optional: consumers providing add_chars_key/add_chars_string receive whole
+// unescaped runs of a string instead of one add_char_* call per byte.
+template <typename T, bool is_key>
+concept StringSpanConsumerConcept = 
+    (requires(T t, std::string_view s) {
+        t.add_chars_key(s);
+    } && (is_key))
+    || 
+    (requires(T t, std::string_view s) {
+        t.add_chars_string(s);
+    } && (!is_key));
+
+// Optional: consumers providing key_raw/string_raw receive a string that is
+// whole in the chunk as one view of the bytes between its quotes, with its
+// escapes still encoded; escaped tells whether there are any (see
+// StringParser::parse_content to decode them). The view points into the
+// caller's buffer. Strings cut by the end of a chunk still go through the
+// calls above.
+template <typename T, bool is_key>
+concept StringRawConsumerConcept = 
+    (requires(T t, std::string_view s) {
+        t.key_raw(s, true);
+    } && (is_key))
+    || 
+    (requires(T t, std::string_view s) {
+        t.string_raw(s, true);
+    } && (!is_key));
+
 
 template <typename T>
 concept NumberConsumerConcept = requires(T t) {
     t.number_begin();
-    t.sing(-1);
+    t.sign(-1);
     t.add_char_int('0');
     t.add_char_frac('0');
     t.add_char_exp('0');
     t.number_end();
 };
 
+// Optional: consumers providing number_value() get the finished number from
+// NumberParser instead of one add_char_* call per character. Integers that
+// fit are delivered as int64_t (or uint64_t above INT64_MAX), everything
+// else as a correctly rounded double.
+template <typename T>
+concept NumberValueConsumerConcept = requires(T t) {
+    t.number_value(int64_t{0});
+    t.number_value(uint64_t{0});
+    t.number_value(double{0});
+};
+
+// Optional, on top of NumberValueConsumerConcept: number_raw() is offered
+// the validated text of each number before it is converted; returning true
+// takes the number as it is and skips the conversion (and number_value).
+// The view is only valid during the call.
+template <typename T>
+concept NumberRawConsumerConcept = requires(T t, std::string_view s) {
+    { t.number_raw(s) } -> std::convertible_to<bool>;
+};
+
 template <typename T>
 concept ValueConsumerConcept = requires(T t) {
     t.set_bool(true);
@@ -100,11 +155,18 @@ class StringParser
 public:
     StringParser(Consumer& consumer, bool is_key = false):status_(Status::begin), uniCount_(0), unicode_(1), consumer_(consumer) {}
     ParseResult parse(const char*& p, const char* end);
+    // Decodes the content of a complete string (the bytes between its
+    // quotes, as handed to key_raw/string_raw) to the consumer.
+    ParseResult parse_content(std::string_view content);
     void reset() { status_ = Status::begin;}
     Consumer& consumer() {return consumer_;}
 private:
     enum class Status {begin, middle, escape, unicode, uni4end};
     void add_char(char c);
+    void add_chars(std::string_view s);
+    void begin_string();
+    void end_string();
+    bool parse_raw(const char*& p, const char* end);
     Status status_;
     int uniCount_;
     uint32_t unicode_;
@@ -114,35 +176,90 @@ private:
 
 
 template <typename Consumer>
-REQUIRES( ValueConsumerConcept<Consumer> )
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
 class NumberParser  {
 public:
     NumberParser(Consumer& consumer): status_(Status::begin), consumer_(consumer){}
     ParseResult parse(const char*& p, const char* end); 
-    void reset() { status_ = Status::begin;}
+    // End of input: a number can only be terminated by the next byte, so the
+    // last value of a document is completed here.
+    ParseResult finish();
+    void reset() { status_ = Status::begin; text_.clear();}
     Consumer& consumer() { return consumer_; }
 private:
-    enum class Status {begin, integer, frac, frac2, exp, exp_first_digit, exp_digits};
+    enum class Status {begin, sign, zero, integer, frac, frac2, exp, exp_first_digit, exp_digits};
+    ParseResult parse_chars(const char*& p, const char* end);
+    ParseResult parse_value(const char*& p, const char* end);
+    bool parse_contiguous(const char*& p, const char* end);
+    const char* digits(const char* p, const char* end, bool fraction);
+    void accumulate(char c);
+    void deliver(std::string_view tail);
+    void number_value(uint64_t mantissa, int64_t exponent, bool negative, bool is_float,
+        bool truncated, std::string_view text);
+
     Status status_;
     Consumer& consumer_;
+
+    // value mode (NumberValueConsumerConcept) state
+    bool negative_ = false;
+    bool is_float_ = false;
+    bool truncated_ = false;     // mantissa_ overflowed: use the slow path
+    bool exp_negative_ = false;
+    uint64_t mantissa_ = 0;      // significant digits, without the point
+    int64_t exponent_ = 0;       // minus the digits after the point
+    int64_t exp_value_ = 0;      // explicit exponent, saturated
+    std::string text_;           // number text, only kept across chunks
 };
 
 
+// Matches a literal known at compile time. A literal whole in the chunk is
+// one fixed size comparison; only a literal cut by the end of a chunk is
+// resumed byte by byte.
+template <reflection::fixed_string Literal>
 class LiteralParser {
 public:
-    LiteralParser(const std::string& literal):pos_(0), literal_(literal){}
+    static constexpr std::string_view literal = Literal;
+
     ParseResult parse(const char*& p, const char* end);
 
     void reset() { pos_=0;}
 
 private:
-    size_t pos_;
-    const std::string& literal_;
+    size_t pos_ = 0;
 };
 
+using NullParser = LiteralParser<"null">;
+using TrueParser = LiteralParser<"true">;
+using FalseParser = LiteralParser<"false">;
+
 
 enum class ValueType {undef, nil, boolean, number, string, object, array};
 
+// What a value starting with a given byte can be. Used to jump straight to
+// the right sub-parser instead of trying each one in turn.
+enum class ValueStart : uint8_t {undef, null_val, true_val, false_val, number, string, object, array};
+
+constexpr std::array<ValueStart, 256> make_value_start_table() {
+    std::array<ValueStart, 256> table{};
+    table['n'] = ValueStart::null_val;
+    table['t'] = ValueStart::true_val;
+    table['f'] = ValueStart::false_val;
+    table['-'] = ValueStart::number;
+    table['+'] = ValueStart::number;
+    for (int c = '0'; c <= '9'; ++c)
+        table[c] = ValueStart::number;
+    table['"'] = ValueStart::string;
+    table['{'] = ValueStart::object;
+    table['['] = ValueStart::array;
+    return table;
+}
+
+inline constexpr std::array<ValueStart, 256> value_start_table = make_value_start_table();
+
+inline ValueStart value_start(char c) {
+    return value_start_table[static_cast<unsigned char>(c)];
+}
+
 template<typename Consumer> 
 REQUIRES(ObjectConsumerConcept<Consumer>)
 class ObjectParser;
@@ -157,7 +274,6 @@ class ValueParser {
 public:
     ValueParser(Consumer& consumer): 
         status_(Status::begin),
-        null_parser_(null_val),true_parser_(true_val), false_parser_(false_val),
         consumer_(consumer),
         number_parser_(consumer.number_consumer()),
         string_parser_(consumer.string_consumer())
@@ -169,13 +285,10 @@ public:
 private:
     enum class Status {begin, true_val, false_val, null_val, number, string, object, array};
     Status status_;
-    static const std::string null_val;
-    static const std::string true_val;
-    static const std::string false_val;
 
-    LiteralParser null_parser_;
-    LiteralParser true_parser_;
-    LiteralParser false_parser_;
+    NullParser null_parser_;
+    TrueParser true_parser_;
+    FalseParser false_parser_;
     NumberParser<typename Consumer::NumberConsumerType> number_parser_;
     StringParser<typename Consumer::StringConsumerType, false> string_parser_;
 
@@ -185,27 +298,24 @@ private:
     Consumer& consumer_;
 };
 
-inline void log_p(const char*& p, int c) {
-    //std::cout <<"log_p " << c << " " << (long int) p << std::endl;
-}
-
 class WhiteSpaceParser {
 public:
     WhiteSpaceParser() = default;
 
     ParseResult parse(const char*& p, const char* end)  {
-        //std::cout << "WhiteSpaceParser::parse P" << (long int) p  << std::endl;
-        while (p != end) {
-            if (!is_ws(*p)) 
-                return ParseResult::ok;
+        // most runs between tokens are empty or a single space; only longer
+        // runs (indentation) are handed to the vectorized kernel
+        if (p != end && is_ws(*p)) {
             ++p;
+            if (p != end && is_ws(*p))
+                p = simd::skip_whitespace(p, end);
         }
-        return ParseResult::partial;
+        return p == end ? ParseResult::partial : ParseResult::ok;
     }
 
 private:
     bool is_ws(char c) {
-        return ( c == ' ' || c == '\t' || c == '\n' || c == '\r');
+        return simd::is_whitespace(c);
     }
 };
 
@@ -263,7 +373,7 @@ public:
     ParseResult parse(const char*& p, const char* end);
     void reset();
 private:
-    enum class Status {begin, value, ws1, sep, ws2};
+    enum class Status {begin, ws0, value, ws1, sep, ws2};
     Status status_;
     ValueParser<typename Consumer::ValueConsumerType> vp_;
     WhiteSpaceParser wsp_;
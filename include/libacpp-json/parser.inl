@@ -4,9 +4,12 @@
 //    (See accompanying file LICENSE or copy at
 //          https://www.mozilla.org/en-US/MPL/2.0/)
 
-#include <iostream>
+#include <bit>
+#include <cstring>
+#include <limits>
 
-#include <libacpp-json/log.h>
+#include <libacpp-json/number.h>
+#include <libacpp-json/simd.h>
 #include <libacpp-json/utils.h>
 
 namespace libacpp::json {
@@ -22,35 +25,161 @@ void StringParser<Consumer, is_key>::add_char(char c) {
         consumer_.add_char_string(c);    
 }
 
+template <typename Consumer, bool is_key>
+REQUIRES( StringConsumerConcept<Consumer, is_key> )
+void StringParser<Consumer, is_key>::add_chars(std::string_view s) {
+    if constexpr (is_key)
+        consumer_.add_chars_key(s);
+    else 
+        consumer_.add_chars_string(s);    
+}
+
+template <typename Consumer, bool is_key>
+REQUIRES( StringConsumerConcept<Consumer, is_key> )
+void StringParser<Consumer, is_key>::begin_string() {
+    if constexpr (is_key)
+        consumer_.key_begin();
+    else 
+        consumer_.string_begin();
+}
+
+template <typename Consumer, bool is_key>
+REQUIRES( StringConsumerConcept<Consumer, is_key> )
+void StringParser<Consumer, is_key>::end_string() {
+    if constexpr (is_key)
+        consumer_.key_end();
+    else 
+        consumer_.string_end();
+}
+
+// Length of the escape sequence at p (a backslash), or 0 when it is
+// malformed or cut by end.
+inline size_t escape_length(const char* p, const char* end) {
+    if (end - p < 2)
+        return 0;
+    switch (p[1]) {
+        case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+            return 2;
+        case 'u': {
+            if (end - p < 6)
+                return 0;
+            uint8_t v;
+            for (int i = 2; i < 6; ++i)
+                if (!is_hex(p[i], v))
+                    return 0;
+            return 6;
+        }
+        default:
+            return 0;
+    }
+}
+
+// p is at the opening quote. When the whole string is in [p, end), the bytes
+// between the quotes go to the consumer as one view. A control byte, a
+// malformed escape or the end of the chunk leave p alone and return false:
+// the state machine takes over and reports them.
+template <typename Consumer, bool is_key>
+REQUIRES( StringConsumerConcept<Consumer, is_key> )
+bool StringParser<Consumer, is_key>::parse_raw(const char*& p, const char* end) {
+    bool escaped = false;
+    [[maybe_unused]] uint64_t escapes = 0;
+    const char* q = p + 1;
+    for (;;) {
+        q = simd::find_string_special(q, end);
+        if (q == end)
+            return false;
+        if (*q == '"')
+            break;
+        if (*q != '\\')
+            return false;
+        size_t len = escape_length(q, end);
+        if (len == 0)
+            return false;
+        escaped = true;
+        ++escapes;
+        q += len;
+    }
+    if (escaped)
+        JSON_TRACE_EVENT(escape, escapes);
+    std::string_view raw(p + 1, static_cast<size_t>(q - p - 1));
+    if constexpr (is_key)
+        consumer_.key_raw(raw, escaped);
+    else 
+        consumer_.string_raw(raw, escaped);
+    p = q + 1;
+    return true;
+}
+
+template <typename Consumer, bool is_key>
+REQUIRES( StringConsumerConcept<Consumer, is_key> )
+ParseResult StringParser<Consumer, is_key>::parse_content(std::string_view content) {
+    begin_string();
+    status_ = Status::middle;
+    const char* p = content.data();
+    ParseResult r = parse(p, p + content.size());
+    // the content ends where the closing quote was: anything but a plain
+    // run (an unquoted '"', a cut escape) is malformed
+    bool complete = r == ParseResult::partial && status_ == Status::middle;
+    status_ = Status::begin;
+    if (!complete)
+        return ParseResult::error;
+    end_string();
+    return ParseResult::ok;
+}
+
 template <typename Consumer, bool is_key>
 REQUIRES( StringConsumerConcept<Consumer, is_key> )
 ParseResult StringParser<Consumer, is_key>::parse(const char*& p, const char* end) {
     while(p != end) {
-        //std::cout << "StringParser::parse *p: " << *p << " " << (long int)p  << " " << (long int)end << std::endl;
         switch(status_) {
             uint8_t v;
             case Status::begin:
-                if constexpr(is_key)
-                    consumer_.key_begin();    
-                else 
-                    consumer_.string_begin();
+                if constexpr (StringRawConsumerConcept<Consumer, is_key>) {
+                    if (*p == '"' && parse_raw(p, end))
+                        return ParseResult::ok;
+                }
+                begin_string();
                 if (*p != '"') {
                     status_  = Status::begin;
                     return ParseResult::error;
                 }
+                if constexpr (StringSpanConsumerConcept<Consumer, is_key>) {
+                    // common case: no escapes and the closing quote in this
+                    // chunk, the whole string is one span
+                    const char* close = simd::find_string_special(p + 1, end);
+                    if (close != end && *close == '"') {
+                        if (close != p + 1)
+                            add_chars(std::string_view(p + 1, close - p - 1));
+                        end_string();
+                        p = close + 1;
+                        return ParseResult::ok;
+                    }
+                }
                 status_ = Status::middle;
                 break;
             case Status::middle:
+                if constexpr (StringSpanConsumerConcept<Consumer, is_key>) {
+                    // hand over the plain run up to the next quote, escape or
+                    // control byte (or the end of this chunk) in one call
+                    const char* run_end = simd::find_string_special(p, end);
+                    if (run_end != p) {
+                        add_chars(std::string_view(p, run_end - p));
+                        p = run_end;
+                        continue;
+                    }
+                }
                 if (*p == '"') {
                     status_  = Status::begin;
-                    if constexpr(is_key)
-                        consumer_.key_end();
-                    else 
-                        consumer_.string_end();
-                    ++p; log_p(p, 1);
+                    end_string();
+                    ++p;
                     return ParseResult::ok;
                 } else if (*p == '\\') {
+                    JSON_TRACE_EVENT(escape, 1);
                     status_ = Status::escape;
+                } else if (static_cast<unsigned char>(*p) < 0x20) {
+                    // control bytes must be escaped
+                    status_  = Status::begin;
+                    return ParseResult::error;
                 } else
                     add_char(*p);
                 break;
@@ -67,19 +196,29 @@ ParseResult StringParser<Consumer, is_key>::parse(const char*& p, const char* en
                 } else if (*p == 'r') {
                     add_char('\r');
                     status_ = Status::middle;
+                } else if (*p == '"' || *p == '/') {
+                    add_char(*p);
+                    status_ = Status::middle;
+                } else if (*p == 'b') {
+                    add_char('\b');
+                    status_ = Status::middle;
+                } else if (*p == 'f') {
+                    add_char('\f');
+                    status_ = Status::middle;
                 } else if (*p == 'u') {
                     status_ = Status::unicode;
                     uniCount_ = 0;
                     unicode_ = 0;
+                } else {
+                    status_  = Status::begin;
+                    return ParseResult::error;
                 }
                 //TODO: fix chars beyond Basic Multilingual Plane
                 break;    
             case Status::unicode:
                 if (is_hex(*p, v) && uniCount_ < 4) {
                     ++ uniCount_;
-//                    std::cout << "uniCount_:" << uniCount_ << "unicode_: " << unicode_  << " *p: " << *p << " v:" << (int)v << std::endl;
                     unicode_ = unicode_ << 4 | (v & 0xf);
-//                     std::cout << "unicode_(2): " << unicode_ << std::endl;
                } else {
                     status_  = Status::begin;
                     return ParseResult::error;
@@ -94,22 +233,298 @@ ParseResult StringParser<Consumer, is_key>::parse(const char*& p, const char* en
             default:
                 break;
         }
-        ++p; log_p(p, 2); 
+        ++p;
     }
     return ParseResult::partial;
 }
 
 
 template <typename Consumer>
-REQUIRES( ValueConsumerConcept<Consumer> )
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
 ParseResult NumberParser<Consumer>::parse(const char*& p, const char* end) {
+    if constexpr (NumberValueConsumerConcept<Consumer>)
+        return parse_value(p, end);
+    else
+        return parse_chars(p, end);
+}
+
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+ParseResult NumberParser<Consumer>::finish() {
+    if constexpr (NumberValueConsumerConcept<Consumer>) {
+        switch(status_) {
+            case Status::zero:
+            case Status::integer:
+            case Status::frac2:
+            case Status::exp_digits:
+                deliver({});
+                return ParseResult::ok;
+            default:
+                return ParseResult::error;
+        }
+    } else {
+        switch(status_) {
+            case Status::integer:
+            case Status::frac2:
+            case Status::exp_digits:
+                consumer_.number_end();
+                status_ = Status::begin;
+                return ParseResult::ok;
+            default:
+                return ParseResult::error;
+        }
+    }
+}
+
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+void NumberParser<Consumer>::accumulate(char c) {
+    uint64_t d = static_cast<uint64_t>(c - '0');
+    if (truncated_)
+        return;
+    if (mantissa_ > (std::numeric_limits<uint64_t>::max() - d) / 10) {
+        truncated_ = true;
+        return;
+    }
+    mantissa_ = mantissa_ * 10 + d;
+}
+
+// Consumes a run of digits into the mantissa. While the run is contiguous in
+// the buffer it is taken 8 digits at a time; mantissa_ < 10^11 guarantees
+// that 8 more digits still fit in 64 bits.
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+const char* NumberParser<Consumer>::digits(const char* p, const char* end, bool fraction) {
+    if constexpr (std::endian::native == std::endian::little) {
+        while (end - p >= 8 && mantissa_ < 100000000000ull) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if (!number::is_8_digits(word))
+                break;
+            mantissa_ = mantissa_ * 100000000 + number::parse_8_digits(word);
+            if (fraction)
+                exponent_ -= 8;
+            p += 8;
+        }
+    }
+    while (p != end && '0' <= *p && *p <= '9') {
+        accumulate(*p);
+        if (fraction)
+            --exponent_;
+        ++p;
+    }
+    return p;
+}
+
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+void NumberParser<Consumer>::number_value(uint64_t mantissa, int64_t exponent, bool negative,
+        bool is_float, bool truncated, std::string_view text) {
+    if constexpr (NumberRawConsumerConcept<Consumer>) {
+        if (consumer_.number_raw(text))
+            return;
+    }
+    if (!is_float && !truncated) {
+        if (!negative) {
+            if (mantissa <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                consumer_.number_value(static_cast<int64_t>(mantissa));
+            else
+                consumer_.number_value(mantissa);
+            return;
+        }
+        if (mantissa <= (uint64_t(1) << 63)) {
+            consumer_.number_value(-static_cast<int64_t>(mantissa - 1) - 1);
+            return;
+        }
+    }
+    double d;
+    if (truncated || !number::compute_double(mantissa, exponent, negative, d))
+        d = number::parse_double(text);
+    consumer_.number_value(d);
+}
+
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+void NumberParser<Consumer>::deliver(std::string_view tail) {
+    std::string_view text = tail;
+    if (!text_.empty()) {
+        text_.append(tail);
+        text = text_;
+    }
+    status_ = Status::begin;
+    number_value(mantissa_, exponent_ + (exp_negative_ ? -exp_value_ : exp_value_),
+        negative_, is_float_, truncated_, text);
+    text_.clear();
+}
+
+// The common case: the whole number, and the byte after it, are in this
+// chunk. Parsed with locals only; anything else (end of chunk, more than 19
+// digits, syntax errors) returns false and is left to the state machine.
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+bool NumberParser<Consumer>::parse_contiguous(const char*& p, const char* end) {
+    const char* q = p;
+    bool negative = *q == '-';
+    q += negative;
+    const char* int_begin = q;
+    uint64_t mantissa = 0;
+    q = number::parse_digits(q, end, mantissa);
+    size_t digit_count = q - int_begin;
+    if (q == end || digit_count == 0 || (digit_count > 1 && *int_begin == '0'))
+        return false;
+    int64_t exponent = 0;
+    bool is_float = false;
+    if (*q == '.') {
+        const char* frac_begin = ++q;
+        q = number::parse_digits(q, end, mantissa);
+        if (q == end || q == frac_begin)
+            return false;
+        digit_count += q - frac_begin;
+        exponent = frac_begin - q;
+        is_float = true;
+    }
+    if (*q == 'e' || *q == 'E') {
+        ++q;
+        bool exp_negative = false;
+        if (q != end && (*q == '-' || *q == '+'))
+            exp_negative = *q++ == '-';
+        const char* exp_begin = q;
+        int64_t exp_value = 0;
+        while (q != end && '0' <= *q && *q <= '9' && exp_value < 100000)
+            exp_value = exp_value * 10 + (*q++ - '0');
+        if (q == end || q == exp_begin || ('0' <= *q && *q <= '9'))
+            return false;
+        exponent += exp_negative ? -exp_value : exp_value;
+        is_float = true;
+    }
+    if (digit_count > 19)
+        return false;
+    number_value(mantissa, exponent, negative, is_float, false, std::string_view(p, q - p));
+    p = q;
+    return true;
+}
+
+// Value mode: RFC 8259 grammar, the number is accumulated here and handed to
+// the consumer in one number_value() call. The number text is only copied
+// when it spans several chunks (for the rare slow path).
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+ParseResult NumberParser<Consumer>::parse_value(const char*& p, const char* end) {
+    if (status_ == Status::begin && p != end && parse_contiguous(p, end))
+        return ParseResult::ok;
+    const char* segment = p;
+    while(p != end) {
+        switch(status_) {
+            case Status::begin:
+                negative_ = false;
+                is_float_ = false;
+                truncated_ = false;
+                exp_negative_ = false;
+                mantissa_ = 0;
+                exponent_ = 0;
+                exp_value_ = 0;
+                if (*p == '-') {
+                    negative_ = true;
+                    status_ = Status::sign;
+                } else if (*p == '0') {
+                    status_ = Status::zero;
+                } else if ('1' <= *p && *p <= '9') {
+                    status_ = Status::integer;
+                    continue;
+                } else {
+                    return ParseResult::error;
+                }
+                break;
+            case Status::sign:
+                if (*p == '0') {
+                    status_ = Status::zero;
+                } else if ('1' <= *p && *p <= '9') {
+                    status_ = Status::integer;
+                    continue;
+                } else {
+                    return ParseResult::error;
+                }
+                break;
+            case Status::zero:
+            case Status::integer:
+                if (status_ == Status::integer) {
+                    p = digits(p, end, false);
+                    if (p == end)
+                        continue;
+                } else if ('0' <= *p && *p <= '9') {
+                    return ParseResult::error; // leading zero
+                }
+                if (*p == '.') {
+                    is_float_ = true;
+                    status_ = Status::frac;
+                } else if (*p == 'e' || *p == 'E') {
+                    is_float_ = true;
+                    status_ = Status::exp;
+                } else {
+                    deliver(std::string_view(segment, p - segment));
+                    return ParseResult::ok;
+                }
+                break;
+            case Status::frac:
+                if ('0' <= *p && *p <= '9') {
+                    status_ = Status::frac2;
+                    continue;
+                }
+                return ParseResult::error;
+            case Status::frac2:
+                p = digits(p, end, true);
+                if (p == end)
+                    continue;
+                if (*p == 'e' || *p == 'E') {
+                    status_ = Status::exp;
+                } else {
+                    deliver(std::string_view(segment, p - segment));
+                    return ParseResult::ok;
+                }
+                break;
+            case Status::exp:
+                if (*p == '-' || *p == '+') {
+                    exp_negative_ = *p == '-';
+                    status_ = Status::exp_first_digit;
+                    break;
+                }
+                [[fallthrough]];
+            case Status::exp_first_digit:
+                if ('0' <= *p && *p <= '9') {
+                    status_ = Status::exp_digits;
+                    continue;
+                }
+                return ParseResult::error;
+            case Status::exp_digits:
+                while (p != end && '0' <= *p && *p <= '9') {
+                    // beyond any double exponent: let the slow path decide
+                    if (exp_value_ < 100000)
+                        exp_value_ = exp_value_ * 10 + (*p - '0');
+                    else
+                        truncated_ = true;
+                    ++p;
+                }
+                if (p == end)
+                    continue;
+                deliver(std::string_view(segment, p - segment));
+                return ParseResult::ok;
+        }
+        ++p;
+    }
+    if (status_ != Status::begin)
+        text_.append(segment, end - segment);
+    return ParseResult::partial;
+}
+
+template <typename Consumer>
+REQUIRES( NumberConsumerConcept<Consumer> || NumberValueConsumerConcept<Consumer> )
+ParseResult NumberParser<Consumer>::parse_chars(const char*& p, const char* end) {
     while(p != end) {
-        ///std::cout << "NumberParser::parse *p: " << *p << " status_: " << (int)status_  << " "<<(long int) p << " " << (long int) end << std::endl;
         switch(status_) {
             case Status::begin:
                 consumer_.number_begin();
                 if (*p == '0') {
-                    ++p; log_p(p, 3);
+                    ++p;
                     status_  = Status::begin;
                     return ParseResult::ok;
                 } else if ( *p == '-') {
@@ -192,20 +607,30 @@ ParseResult NumberParser<Consumer>::parse(const char*& p, const char* end) {
             default:
                 break;
         }
-        ++p; log_p(p, 4);
+        ++p;
     }
     return ParseResult::partial;
 }
 
-template<typename Consumer>
-REQUIRES(ValueConsumerConcept<Consumer>)
-const std::string ValueParser<Consumer>::null_val = "null";
-template<typename Consumer>
-REQUIRES(ValueConsumerConcept<Consumer>)
-const std::string ValueParser<Consumer>::true_val = "true";
-template<typename Consumer>
-REQUIRES(ValueConsumerConcept<Consumer>)
-const std::string ValueParser<Consumer>::false_val = "false";
+template <reflection::fixed_string Literal>
+ParseResult LiteralParser<Literal>::parse(const char*& p, const char* end) {
+    if (pos_ == 0 && static_cast<size_t>(end - p) >= literal.size()) {
+        // constant size: compiled to one 4 byte load and compare (plus one
+        // byte for "false")
+        if (std::memcmp(p, literal.data(), literal.size()) != 0)
+            return ParseResult::error;
+        p += literal.size();
+        return ParseResult::ok;
+    }
+    while (p != end) {
+        if (*p != literal[pos_])
+            return ParseResult::error;
+        ++p;
+        if (++pos_ == literal.size())
+            return ParseResult::ok;
+    }
+    return ParseResult::partial;
+}
 
 
 template <typename Consumer>
@@ -237,81 +662,54 @@ struct guard {
 template <typename Consumer>
 REQUIRES(ValueConsumerConcept<Consumer>)
 ParseResult ValueParser<Consumer>::parse(const char*& p, const char* end) {
-    //std::cout <<"ValueParser::parse \n";
-
+    JSON_TRACE_SCOPE(p);
     ParseResult r = ParseResult::partial;
     guard g;
-        //std::cout << "ValueParser::parse begin: " << (long int)p << " " << (long int)end << " status_: " << (int)status_ << std::endl;
     while(p < end && r != ParseResult::ok) {
         g.current(p);
-        //std::cout << "ValueParser::parse " << *p << " p:" << (long int)p  << " end:" << (long int)end  << " r: " << (int)r << " status_: " << (int)status_ << std::endl;
-        switch(status_) {
-            case Status::begin:
-                //null
-                status_ = Status::null_val;
-                r = null_parser_.parse(p, end);
-                if (r == ParseResult::ok){
-                    consumer_.set_null();
-                } 
-                //true
-                if (r == ParseResult::error) {
+        if (status_ == Status::begin) {
+            // the first byte decides the sub-parser, which is then resumed
+            // below like on any later call
+            switch(value_start(*p)) {
+                case ValueStart::null_val:
+                    status_ = Status::null_val;
+                    null_parser_.reset();
+                    break;
+                case ValueStart::true_val:
                     status_ = Status::true_val;
-                    r = true_parser_.parse(p, end);
-                    if (r == ParseResult::ok){
-                        consumer_.set_bool(true);
-                    } 
-                }
-                //false
-                if (r == ParseResult::error) {
+                    true_parser_.reset();
+                    break;
+                case ValueStart::false_val:
                     status_ = Status::false_val;
-                    r = false_parser_.parse(p, end);
-                    if (r == ParseResult::ok){
-                        consumer_.set_bool(false);
-                    } 
-                }
-                //number
-                if (r == ParseResult::error) {
+                    false_parser_.reset();
+                    break;
+                case ValueStart::number:
                     status_ = Status::number;
-                    r = number_parser_.parse(p, end);
-                    if (r == ParseResult::ok) {
-                        //consumer_.set_number();
-                    }
-                }
-                //string
-                if (r == ParseResult::error) {
+                    number_parser_.reset();
+                    break;
+                case ValueStart::string:
                     status_ = Status::string;
-                    r = string_parser_.parse(p, end);
-                    if (r == ParseResult::ok) {
-//                        consumer_.set_string();
-                    }
-                }
-                //object
-                if (r == ParseResult::error) {
+                    string_parser_.reset();
+                    break;
+                case ValueStart::object:
                     status_ = Status::object;
                     if (!object_parser_) {
                         object_parser_  = std::make_unique<ObjectParser<typename Consumer::ObjectConsumerType>>(consumer_.object_consumer());    
                     }
                     object_parser_->reset();
-                    r = object_parser_->parse(p, end);
-                }
-                //array
-                if (r == ParseResult::error) {
+                    break;
+                case ValueStart::array:
                     status_ = Status::array;
                     if (!array_parser_)
                         array_parser_ = std::make_unique<ArrayParser<typename Consumer::ArrayConsumerType>>(consumer_.array_consumer());    
                     array_parser_->reset();    
-                    r = array_parser_->parse(p, end);
-                }
-
-                //std::cout <<"ValueParser::parse r= " << to_string(r) << " " << (int)status_ <<" " << (int)type_ << std::endl;
-                if (r == ParseResult::error){
-                    //parse object and value
-                    std::cout <<"ERROR ************" << std::endl;
-                    return r;
-                } 
-                break;
+                    break;
+                default:
+                    return JSON_TRACE_RESULT(ParseResult::error, p);
+            }
+        }
+        switch(status_) {
             case Status::true_val:
-                //std::cout <<"true_parser_.parse" << std::endl;
                 r = true_parser_.parse(p, end);
                 if (r == ParseResult::ok) {
                     consumer_.set_bool(true);
@@ -336,21 +734,18 @@ ParseResult ValueParser<Consumer>::parse(const char*& p, const char* end) {
                 }
                 break;
             case Status::string:
-                //std::cout <<"string_parser_.parse p:" << (long int) p  << " e: "<< (long int) end << std::endl;
                 r = string_parser_.parse(p, end);
                 if (r == ParseResult::ok) {
 //                    consumer_.set_string();
                 }
                 break;
             case Status::object:
-                //std::cout <<"object_parser_.parse p:" << (long int) p  << " e: "<< (long int) end << std::endl;
                 r = object_parser_->parse(p, end);
                 if (r == ParseResult::ok) {
                     //type_ = ValueType::object;
                 }
                 break;
             case Status::array:
-                //std::cout <<"object_parser_.parse p:" << (long int) p  << " e: "<< (long int) end << std::endl;
                 r = array_parser_->parse(p, end);
                 if (r == ParseResult::ok) {
                     //type_ = ValueType::object;
@@ -360,17 +755,15 @@ ParseResult ValueParser<Consumer>::parse(const char*& p, const char* end) {
                 break;
         }
         if (r==ParseResult::error)
-            return r;
+            return JSON_TRACE_RESULT(r, p);
     }
-    return r;
+    return JSON_TRACE_RESULT(r, p);
 }
 
 template<typename Consumer>
 REQUIRES(KeyValueConsumerConcept<Consumer>)
 ParseResult KeyValueParser<Consumer>::parse(const char*& p, const char* end)  {
-    //std::cout << "KeyValueParser::parse sep p:"  << (long int)p << " end:"  << (long int)end  << std::endl; 
     while(p != end) {
-        //std::cout << "KeyValueParser::parse *p: " << *p << " " << (long int)p << " " << (long int)end  << " " << " status_: " << (int)status_ << std::endl;
         ParseResult result = ParseResult::partial;
         switch(status_) {
             case Status::ws1:
@@ -386,7 +779,6 @@ ParseResult KeyValueParser<Consumer>::parse(const char*& p, const char* end)  {
                 }
                 break;
             case Status::ws2:
-                //std::cout << "KeyValueParser::parse ws2 *p:"  << *p << std::endl; 
                 result = wsp_.parse(p, end);
                 if (result == ParseResult::ok)
                     status_ = Status::sep;
@@ -395,7 +787,7 @@ ParseResult KeyValueParser<Consumer>::parse(const char*& p, const char* end)  {
                 if (*p == ':') {
                     // we have separator, key is ok. we could set that in the StringParser
                     status_ = Status::ws3;
-                    ++p;  log_p(p, 5);
+                    ++p;
                     if (p == end)
                         return result;    
                 }
@@ -410,7 +802,6 @@ ParseResult KeyValueParser<Consumer>::parse(const char*& p, const char* end)  {
                 }
                 break;
             case Status::value:
-                //std::cout << "KeyValueParser::parse value *p:"  << *p << std::endl; 
                 result = vp_.parse(p, end);
                 if (result == ParseResult::ok) {
                     status_ = Status::ws1;
@@ -422,7 +813,6 @@ ParseResult KeyValueParser<Consumer>::parse(const char*& p, const char* end)  {
                 break;
         }
         if (result == ParseResult::error) {
-            //std::cout << "KeyValueParser::parse error" << std::endl; 
             return result;    
         }
     }
@@ -440,17 +830,14 @@ template<typename Consumer>
 REQUIRES(ObjectConsumerConcept<Consumer>)
 ObjectParser<Consumer>::ObjectParser(Consumer& consumer)
 :status_(Status::begin), consumer_(consumer), kvp_(consumer) {
-    //std::cout << "ObjectParser::ObjectParser  NEW"  << std::endl;
 }
 
 
 template<typename Consumer>
 REQUIRES(ObjectConsumerConcept<Consumer>)
 ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
-    //std::cout << "ObjectParser::parse *** p: " << (long int)p << " end: " << (long int)end << std::endl;
     ParseResult result = ParseResult::partial;
     while(p != end) {
-        //std::cout << "ObjectParser::parse *p: " << *p  << " status: " << (int)status_ << " p " << (long int)p << " end: " << (long int)end << std::endl;
         ParseResult r;
         switch(status_) {
             case Status::begin:
@@ -458,8 +845,9 @@ ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
                     return ParseResult::error;
                 }
                 consumer_.object_begin();
+                JSON_TRACE_EVENT(container_begin);
                 status_ = Status::ws0;
-                ++p;  log_p(p, 6);
+                ++p;
                 if (p == end)
                     return result;
                 break;
@@ -467,7 +855,10 @@ ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
                 r = wsp_.parse(p, end);
                 if ( r == ParseResult::ok) {
                     if(*p == '}') {
-                        //std::cout << "*p:"  << *p << std::endl; 
+                        ++p;
+                        consumer_.object_end();
+                        JSON_TRACE_EVENT(container_end);
+                        status_ = Status::begin; 
                         return ParseResult::ok;
                     } else {
                         kvp_.reset(); //TODO: needed?
@@ -478,23 +869,12 @@ ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
                 }
                 break;
             case Status::key_value:
-                //std::cout << "ObjectParser::parse keyvalue (1) *p: " << *p  << " status: " << (int)status_  << " p:" << (long int) p << std::endl;
                 r = kvp_.parse(p, end);
-                //std::cout << "ObjectParser::parse keyvalue (2) *p: " << *p  << " status: " << (int)status_  << " p:" << (long int) p << std::endl;
                 if (r == ParseResult::ok) {
-                    if (*p == '}') {
-                        consumer_.object_end();
-                        status_ = Status::begin; 
-                        return ParseResult::ok;
-                    }
-                    // if (*p == ']') {
-                    //     visitor_.end_array();
-                    //     status_ = Status::begin; 
-                    //     return ParseResult::ok;
-                    // }
+                    // the value may end exactly at the end of the chunk, so
+                    // the closing '}' or ',' is looked for in ws1/sep
                     status_ = Status::ws1;
                 } else if (r == ParseResult::error){
-                    JSON_LOG_TRACE("ObjectParser::parse  ERROR **************");
                     return ParseResult::error;
                 }
                 break;
@@ -502,26 +882,21 @@ ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
                 r = wsp_.parse(p, end);
                 if ( r == ParseResult::ok) {
                     status_ = Status::sep;
-                    if (*p == '}') {
-                        consumer_.object_end();
-                        status_ = Status::begin; 
-                        return ParseResult::ok;
-                    }
                 }
                 else if (r==ParseResult::error)
                     return ParseResult::error;    
                 break;
             case Status::sep:
-                //std::cout << "*p:"  << *p << std::endl; 
                 if (*p == ',') {
                     status_ = Status::ws2;
-                    ++p; log_p(p, 7);
+                    ++p;
                     if (p == end)
                         return result;
                 } else if (*p == '}') {
-                    ++p; log_p(p, 8);
-                    if (p == end)
-                        return result;
+                    ++p;
+                    consumer_.object_end();
+                    JSON_TRACE_EVENT(container_end);
+                    status_ = Status::begin; 
                     return ParseResult::ok;    
                 } else 
                     return ParseResult::error;    
@@ -529,13 +904,11 @@ ParseResult ObjectParser<Consumer>::parse(const char*& p, const char* end) {
             case Status::ws2:
                 r = wsp_.parse(p, end);
                 if ( r == ParseResult::ok) {
-                    if(*p == '}') {
-                        //std::cout << "*p:"  << *p << std::endl; 
-                        return ParseResult::ok;
-                    } else {
-                        kvp_.reset(); //TODO: needed?
-                        status_ = Status::key_value;
-                    }
+                    // a member must follow the comma
+                    if(*p == '}')
+                        return ParseResult::error;
+                    kvp_.reset(); //TODO: needed?
+                    status_ = Status::key_value;
                 } else if ( r == ParseResult::error) {
                     return ParseResult::error;
                 }
@@ -552,7 +925,6 @@ template<typename Consumer>
 REQUIRES(ArrayConsumerConcept<Consumer>)
 ArrayParser<Consumer>::ArrayParser(Consumer& consumer)
 :consumer_(consumer), vp_(consumer), status_(Status::begin) {
-    //std::cout << "ArrayParser::ArrayParser  NEW"  << std::endl;
 }
 
 template<typename Consumer>
@@ -565,50 +937,56 @@ void ArrayParser<Consumer>::reset() {
 template<typename Consumer>
 REQUIRES(ArrayConsumerConcept<Consumer>)
 ParseResult ArrayParser<Consumer>::parse(const char*& p, const char* end) {
-    //std::cout << "ArrayParser::parse p: " << (long int) p << " end: " << (long int)end << std::endl;
     ParseResult result = ParseResult::partial;
     while(p != end) {
-        //std::cout << "ArrayParser::parse *p: " << *p  << " status: " << (int)status_ << " p: " << (long int) p << " end: " << (long int)end << std::endl;
+        ParseResult r;
         switch(status_) {
             case Status::begin:
                 if (*p != '[') {
                     return ParseResult::error;
                 }
                 consumer_.array_begin();
-                status_ = Status::value;
-                ++p; log_p(p, 9);
+                JSON_TRACE_EVENT(container_begin);
+                status_ = Status::ws0;
+                ++p;
                 if (p == end)
                     return ParseResult::partial;
                 break;
+            case Status::ws0:
+                if (wsp_.parse(p, end) == ParseResult::ok) {
+                    if(*p == ']') {
+                        ++p;
+                        consumer_.array_end();
+                        JSON_TRACE_EVENT(container_end);
+                        status_ = Status::begin; 
+                        return ParseResult::ok;
+                    }
+                    vp_.reset();
+                    status_ = Status::value;
+                }
+                break;
             case Status::value:
-                //std::cout << "ArrayParser::parse value(1) *********** end p" << (long int) p << std::endl;
-                if (vp_.parse(p, end) == ParseResult::ok) {
-                    // if (*p == ']') {
-                    //     std::cout << "ArrayParser::parse value(2) *********** end p" << (long int) p << std::endl;
-                    //     consumer_.array_end();
-                    //     status_ = Status::begin; 
-                    //     ++p; log_p(p, 10);
-                    //     return ParseResult::ok;
-                    // }
-                    
-                    //std::cout << "ArrayParser::parse value *********** " << std::endl;
+                r = vp_.parse(p, end);
+                if (r == ParseResult::ok) {
                     status_ = Status::ws1;
-                }
+                } else if (r == ParseResult::error)
+                    return ParseResult::error;
                 break;
             case Status::ws1:
                 if (wsp_.parse(p, end) == ParseResult::ok)
                     status_ = Status::sep;
                 break;
             case Status::sep:
-                //std::cout << "*p:"  << *p << std::endl; 
                 if (*p == ',') {
                     status_ = Status::ws2;
-                    ++p; log_p(p, 11);
+                    ++p;
                     if (p == end)
                         return ParseResult::partial;
                 } else if (*p == ']') {
-                    ++p; log_p(p, 12);
+                    ++p;
                     consumer_.array_end();
+                    JSON_TRACE_EVENT(container_end);
+                    status_ = Status::begin; 
                     return ParseResult::ok;    
                 } else 
                     return ParseResult::error;    
@@ -616,11 +994,9 @@ ParseResult ArrayParser<Consumer>::parse(const char*& p, const char* end) {
             case Status::ws2:
 
                 if (wsp_.parse(p, end) == ParseResult::ok) {
+                    // a value must follow the comma
                     if(*p == ']') {
-                        ++p; log_p(p, 13);
-                        consumer_.array_end();
-                        //std::cout << "*p:"  << *p << std::endl; 
-                        return ParseResult::ok;
+                        return ParseResult::error;
                     } else {
                         vp_.reset(); //TODO: needed?
                         status_ = Status::value;
@@ -0,0 +1,91 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "consumer.h"
+
+namespace libacpp::json {
+
+// A path to a value inside documents, parsed once and then resolved against
+// any number of them. Each step keeps its key decoded and hashed, its array
+// index converted, and the position where it last found its member: when
+// the documents share a shape, as the records of a stream do, a lookup
+// checks that position first and costs one key comparison per level.
+// Otherwise objects are searched as find() does (through their index past
+// OrderedObject::hash_threshold members) and arrays are indexed directly.
+//
+// Resolving does not change the documents. The cached positions are
+// relaxed atomics, so a path may be shared by threads.
+class JsonPath {
+public:
+    JsonPath() = default; // the whole document
+
+    // RFC 6901 JSON Pointer: "" or a sequence of "/" followed by a token,
+    // with "~0" for '~' and "~1" for '/' ("/a~1b/0"). Throws
+    // std::invalid_argument when it is malformed.
+    static JsonPath pointer(std::string_view pointer);
+    // Dotted path: keys separated by '.', and array indexes either as keys
+    // or in brackets ("a.b[2].c", "a.b.2.c"); "" is the whole document.
+    // Keys cannot contain '.', '[' or ']' (use a pointer for those).
+    // Throws std::invalid_argument when it is malformed.
+    static JsonPath dotted(std::string_view path);
+
+    // the value at the path, nullptr when it is not there
+    const JsonValue* find(const JsonValue& root) const;
+    JsonValue* find(JsonValue& root) const {
+        return const_cast<JsonValue*>(find(static_cast<const JsonValue&>(root)));
+    }
+    // the same, throwing std::out_of_range when it is not there
+    const JsonValue& at(const JsonValue& root) const;
+
+    size_t size() const { return steps_.size(); }
+    bool empty() const { return steps_.empty(); }
+    // the path as a JSON Pointer
+    std::string str() const;
+
+private:
+    static constexpr size_t no_index = SIZE_MAX;
+
+    struct Step {
+        std::string key;
+        size_t hash;
+        size_t index;   // key as an array index, no_index when it is not one
+        mutable std::atomic<uint32_t> hint{0};
+
+        explicit Step(std::string k);
+        Step(const Step& other): key(other.key), hash(other.hash), index(other.index),
+            hint(other.hint.load(std::memory_order_relaxed)) {}
+        Step& operator=(const Step& other) {
+            key = other.key;
+            hash = other.hash;
+            index = other.index;
+            hint.store(other.hint.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    const JsonValue* member(const JsonObject& object, const Step& step) const;
+
+    std::vector<Step> steps_;
+};
+
+// One-off lookups; a JsonPath avoids parsing the path at every call.
+inline const JsonValue* find_pointer(const JsonValue& root, std::string_view pointer) {
+    return JsonPath::pointer(pointer).find(root);
+}
+inline const JsonValue* find_path(const JsonValue& root, std::string_view path) {
+    return JsonPath::dotted(path).find(root);
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,89 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+#include "parser.h"
+
+namespace libacpp::json {
+
+// A number kept as its source text, converted the first time it is read
+// as a number. Documents that only pass numbers through (to a writer, to
+// another store) never pay for the conversion, and no digit is lost.
+// The text must be a valid JSON number; JsonConsumer only builds them from
+// numbers the parser validated. Reading is not synchronized: share one
+// across threads only once it has been converted.
+class JsonRawNumber {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    JsonRawNumber() = default;
+    explicit JsonRawNumber(std::string_view text, const allocator_type& alloc = {}): text_(text, alloc) {}
+
+    std::string_view text() const { return text_; }
+
+    // an integer that fits in 64 bits, as the parser would deliver it
+    bool is_int64() const { return std::holds_alternative<int64_t>(value()); }
+    bool is_uint64() const { return std::holds_alternative<uint64_t>(value()); }
+
+    // nullopt when the number is not an integer of that range
+    std::optional<int64_t> as_int64() const {
+        if (auto v = std::get_if<int64_t>(&value()))
+            return *v;
+        return std::nullopt;
+    }
+    std::optional<uint64_t> as_uint64() const {
+        if (auto v = std::get_if<uint64_t>(&value()))
+            return *v;
+        if (auto v = std::get_if<int64_t>(&value()); v && *v >= 0)
+            return static_cast<uint64_t>(*v);
+        return std::nullopt;
+    }
+    // any number, correctly rounded
+    double as_double() const {
+        return std::visit([](auto v) -> double {
+            if constexpr (std::is_same_v<decltype(v), std::monostate>)
+                return 0;
+            else
+                return static_cast<double>(v);
+        }, value());
+    }
+
+    bool operator==(const JsonRawNumber& other) const { return text_ == other.text_; }
+
+private:
+    using Value = std::variant<std::monostate, int64_t, uint64_t, double>;
+
+    // receives the value of the number from NumberParser
+    struct Converter {
+        Value& value;
+        void number_value(int64_t v) { value = v; }
+        void number_value(uint64_t v) { value = v; }
+        void number_value(double v) { value = v; }
+    };
+
+    const Value& value() const {
+        if (std::holds_alternative<std::monostate>(value_)) {
+            Converter converter{value_};
+            NumberParser<Converter> parser(converter);
+            const char* p = text_.data();
+            if (parser.parse(p, p + text_.size()) == ParseResult::partial)
+                parser.finish();
+        }
+        return value_;
+    }
+
+    std::pmr::string text_;
+    mutable Value value_;
+};
+
+} // namespace libacpp::json
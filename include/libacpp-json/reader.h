@@ -0,0 +1,174 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "parser.h"
+
+namespace libacpp::json {
+
+namespace detail {
+
+// Gathers a key or a string value for JsonReader: a view of the chunk when
+// it is whole there without escapes, the decoded bytes otherwise.
+class ReaderText {
+public:
+    std::string_view view() const { return view_; }
+
+    void string_begin() { text_.clear(); }
+    void add_char_string(char c) { text_.push_back(c); }
+    void add_chars_string(std::string_view s) { text_.append(s); }
+    void string_end() { view_ = text_; }
+    void string_raw(std::string_view raw, bool escaped);
+
+    void key_begin() { string_begin(); }
+    void add_char_key(char c) { add_char_string(c); }
+    void add_chars_key(std::string_view s) { add_chars_string(s); }
+    void key_end() { string_end(); }
+    void key_raw(std::string_view raw, bool escaped) { string_raw(raw, escaped); }
+
+private:
+    std::string text_;
+    std::string_view view_;
+};
+
+// Keeps the text and the value of a number for JsonReader.
+class ReaderNumber {
+public:
+    using Value = std::variant<int64_t, uint64_t, double>;
+
+    std::string_view text() const { return text_; }
+    const Value& value() const { return value_; }
+
+    bool number_raw(std::string_view text) {
+        text_.assign(text);
+        return false;
+    }
+    void number_value(int64_t v) { value_ = v; }
+    void number_value(uint64_t v) { value_ = v; }
+    void number_value(double v) { value_ = v; }
+
+private:
+    std::string text_;
+    Value value_;
+};
+
+} // namespace detail
+
+// Pull parser: the caller asks for one token at a time with next(), instead
+// of receiving every event in a consumer, and can skip() the values it does
+// not need without tokenizing them. It runs on the same resumable parsers
+// as ValueParser for strings, numbers and literals, so the input may be cut
+// anywhere: when a chunk is exhausted next() returns need_input, and the
+// token in progress resumes with the next chunk.
+//
+//     reader.feed(chunk);
+//     for (Token t = reader.next(); t.kind < Kind::need_input; t = reader.next())
+//         if (t.kind == Kind::key && t.text != "id")
+//             reader.skip();
+//
+// One document per reader; reset() starts another.
+class JsonReader {
+public:
+    static constexpr size_t default_max_depth = 1024;
+
+    // the tokens come before need_input
+    enum class Kind : uint8_t {object_begin, object_end, array_begin, array_end, key, string, number,
+        boolean, null,
+        need_input,     // the chunk is consumed: feed() the next one, or finish()
+        end,            // the document is complete and so is the input
+        error};
+
+    // text: the key or the string, decoded, or the number as written; it
+    // may point into the chunk and is valid until the next call to next().
+    struct Token {
+        Kind kind = Kind::error;
+        std::string_view text = {};
+        bool boolean = false;
+        detail::ReaderNumber::Value number = {};
+    };
+
+    explicit JsonReader(size_t max_depth = default_max_depth);
+
+    JsonReader(const JsonReader&) = delete;
+    JsonReader& operator=(const JsonReader&) = delete;
+
+    // The next chunk of input, once next() returned need_input (or before
+    // the first call). It must stay valid until next() returns need_input
+    // again.
+    void feed(std::string_view chunk) {
+        p_ = chunk.data();
+        end_ = p_ + chunk.size();
+    }
+    // No more input: completes a number at the end of the document, and
+    // next() then returns end, or error when the document is not complete.
+    void finish() { finished_ = true; }
+
+    Token next();
+
+    // After a key token, skips the value of the member. Anywhere else, skips
+    // what is left of the innermost container, its end included (at the top
+    // level, nothing). Skipped values are scanned for their strings and
+    // brackets only, without being validated; the scan resumes across
+    // chunks inside next(), which returns the token after them.
+    void skip();
+
+    // Forgets the document and the input.
+    void reset();
+
+    // open containers
+    size_t depth() const { return stack_.size(); }
+
+private:
+    enum class Status {value, object_first, object_key, key, colon, object_next, array_first, array_next,
+        string, number, null_val, true_val, false_val, skip, done, failed};
+    // what skip() is going through: the colon of a member, the first byte
+    // of the value, a number or a literal, strings and brackets
+    enum class Skip {colon, value, scalar, bytes};
+
+    Token token(Kind kind) { return Token{kind}; }
+    Token fail();
+    // the bracket at p_
+    Token open(bool object);
+    Token close();
+    // t once its parser returned r
+    Token scalar(ParseResult r, Token t);
+    void end_value();
+    // true once the skipped bytes are behind
+    bool skip_bytes();
+
+    Status status_ = Status::value;
+    std::vector<bool> stack_;   // the open containers, true for objects
+    size_t max_depth_;
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;
+    bool finished_ = false;
+
+    detail::ReaderText text_;
+    detail::ReaderNumber number_;
+    StringParser<detail::ReaderText, true> key_parser_;
+    StringParser<detail::ReaderText, false> string_parser_;
+    NumberParser<detail::ReaderNumber> number_parser_;
+    NullParser null_parser_;
+    TrueParser true_parser_;
+    FalseParser false_parser_;
+
+    // skip state
+    Skip skip_ = Skip::value;
+    size_t skip_depth_ = 0;     // brackets open in the skipped bytes
+    bool skip_in_string_ = false;
+    bool skip_escape_ = false;  // the byte after a backslash is next
+    bool skip_pop_ = false;     // the skipped bytes close a container of stack_
+};
+
+} // namespace libacpp::json
@@ -0,0 +1,100 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #define ACPPJSON_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ACPPJSON_SSE2 1
+#endif
+
+#if defined(ACPPJSON_AVX2)
+    #include <immintrin.h>
+#elif defined(ACPPJSON_SSE2)
+    #include <emmintrin.h>
+#endif
+
+namespace libacpp::json::simd {
+
+inline bool is_whitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Whitespace kernels: return the first non-whitespace position in [p, end),
+// or end. All variants give the same result; skip_whitespace() picks the
+// widest one the running CPU supports the first time it is called.
+const char* skip_whitespace_scalar(const char* p, const char* end);
+const char* skip_whitespace_sse2(const char* p, const char* end);
+const char* skip_whitespace_avx2(const char* p, const char* end);
+
+bool has_sse2();
+bool has_avx2();
+
+using skip_whitespace_fn = const char* (*)(const char* p, const char* end);
+skip_whitespace_fn skip_whitespace_kernel();
+const char* skip_whitespace_kernel_name();
+
+inline const char* skip_whitespace(const char* p, const char* end) {
+    return skip_whitespace_kernel()(p, end);
+}
+
+inline bool is_string_special(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+// Returns the first position in [p, end) holding '"', '\\' or a control
+// character, or end when the whole range is plain string content.
+inline const char* find_string_special(const char* p, const char* end) {
+#if defined(ACPPJSON_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i bslash32 = _mm256_set1_epi8('\\');
+    const __m256i ctrl32 = _mm256_set1_epi8(0x1f);
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, bslash32)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl32), v)); // v <= 0x1f
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+        if (mask != 0)
+            return p + std::countr_zero(mask);
+        p += 32;
+    }
+#endif
+#if defined(ACPPJSON_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i bslash = _mm_set1_epi8('\\');
+    const __m128i ctrl = _mm_set1_epi8(0x1f);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v)); // v <= 0x1f
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+        if (mask != 0)
+            return p + std::countr_zero(mask);
+        p += 16;
+    }
+#endif
+    while (p != end && !is_string_special(*p))
+        ++p;
+    return p;
+}
+
+// The first '\n' in [p, end), or end. memchr is already vectorized by the
+// C libraries we build with.
+inline const char* find_newline(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+} // namespace libacpp::json::simd
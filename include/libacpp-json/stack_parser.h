@@ -0,0 +1,85 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <concepts>
+#include <variant>
+#include <vector>
+
+#include "parser.h"
+
+namespace libacpp::json {
+
+#if __cpp_concepts
+
+// The stack engine keeps one frame type for every nesting level, so the value
+// consumer reached from inside an object or an array must be of the same type
+// as the top level one (instances may still differ per level).
+template <typename T>
+concept StackConsumerConcept = ValueConsumerConcept<T>
+    && std::same_as<typename T::ObjectConsumerType::KeyValueConsumerType::ValueConsumerType, T>
+    && std::same_as<typename T::ArrayConsumerType::ValueConsumerType, T>;
+
+#endif
+
+
+// Drives the same consumers as ValueParser from a single state machine.
+// Nesting is tracked in a contiguous stack reserved once at construction
+// (max_depth frames), so no allocation happens per level and resuming a
+// partial parse only looks at the innermost frame, whatever the depth.
+// Documents nested deeper than max_depth are reported as errors.
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+class StackParser {
+public:
+    static constexpr size_t default_max_depth = 1024;
+
+    StackParser(Consumer& consumer, size_t max_depth = default_max_depth);
+    ParseResult parse(const char*& p, const char* end);
+    void reset();
+
+    size_t depth() const { return stack_.size(); }
+    size_t max_depth() const { return max_depth_; }
+
+private:
+    using ObjectConsumer = typename Consumer::ObjectConsumerType;
+    using KeyValueConsumer = typename ObjectConsumer::KeyValueConsumerType;
+    using ArrayConsumer = typename Consumer::ArrayConsumerType;
+
+    using KeyParser = StringParser<typename KeyValueConsumer::KeyConsumerType, true>;
+    using StringValueParser = StringParser<typename Consumer::StringConsumerType, false>;
+    using NumberValueParser = NumberParser<typename Consumer::NumberConsumerType>;
+
+    enum class Status {value, object_first, object_key, key, colon, object_next,
+        array_first, array_next, string, number, null_val, true_val, false_val, done};
+
+    // one nesting level: exactly one of the two pointers is set
+    struct Frame {
+        ObjectConsumer* object;
+        ArrayConsumer* array;
+    };
+
+    ParseResult run(const char*& p, const char* end);
+    Consumer& value_consumer();
+    ParseResult begin_value(const char*& p);
+    ParseResult push(const Frame& frame);
+    void close();
+    void end_value();
+
+    Status status_;
+    size_t max_depth_;
+    std::vector<Frame> stack_;
+    WhiteSpaceParser wsp_;
+    std::variant<std::monostate, KeyParser, StringValueParser, NumberValueParser,
+        NullParser, TrueParser, FalseParser> scalar_;
+    Consumer& consumer_;
+};
+
+} // namespace libacpp::json
+
+
+#include "stack_parser.inl"
@@ -0,0 +1,250 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+namespace libacpp::json {
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+StackParser<Consumer>::StackParser(Consumer& consumer, size_t max_depth)
+:status_(Status::value), max_depth_(max_depth), consumer_(consumer) {
+    stack_.reserve(max_depth_);
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+void StackParser<Consumer>::reset() {
+    status_ = Status::value;
+    stack_.clear();
+    scalar_.template emplace<std::monostate>();
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+Consumer& StackParser<Consumer>::value_consumer() {
+    if (stack_.empty())
+        return consumer_;
+    const Frame& top = stack_.back();
+    if (top.object) {
+        KeyValueConsumer& kv = *top.object;
+        return kv.value_consumer();
+    }
+    return top.array->value_consumer();
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult StackParser<Consumer>::push(const Frame& frame) {
+    if (stack_.size() == max_depth_)
+        return ParseResult::error;
+    stack_.push_back(frame);
+    return ParseResult::ok;
+}
+
+// Called when a value (scalar or container) has been completed: the next
+// expected token depends only on the enclosing frame.
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+void StackParser<Consumer>::end_value() {
+    if (stack_.empty())
+        status_ = Status::done;
+    else if (stack_.back().object)
+        status_ = Status::object_next;
+    else
+        status_ = Status::array_next;
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+void StackParser<Consumer>::close() {
+    Frame top = stack_.back();
+    stack_.pop_back();
+    if (top.object)
+        top.object->object_end();
+    else
+        top.array->array_end();
+    JSON_TRACE_EVENT(container_end);
+    end_value();
+}
+
+// Picks the parser for the value starting at *p. Containers consume their
+// opening bracket here; scalars are left to their sub-parser.
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult StackParser<Consumer>::begin_value(const char*& p) {
+    Consumer& consumer = value_consumer();
+    switch (value_start(*p)) {
+        case ValueStart::object: {
+            ObjectConsumer& object = consumer.object_consumer();
+            if (push(Frame{&object, nullptr}) == ParseResult::error)
+                return ParseResult::error;
+            object.object_begin();
+            JSON_TRACE_EVENT(container_begin);
+            status_ = Status::object_first;
+            ++p;
+            break;
+        }
+        case ValueStart::array: {
+            ArrayConsumer& array = consumer.array_consumer();
+            if (push(Frame{nullptr, &array}) == ParseResult::error)
+                return ParseResult::error;
+            array.array_begin();
+            JSON_TRACE_EVENT(container_begin);
+            status_ = Status::array_first;
+            ++p;
+            break;
+        }
+        case ValueStart::string:
+            scalar_.template emplace<StringValueParser>(consumer.string_consumer());
+            status_ = Status::string;
+            break;
+        case ValueStart::number:
+            scalar_.template emplace<NumberValueParser>(consumer.number_consumer());
+            status_ = Status::number;
+            break;
+        case ValueStart::null_val:
+            scalar_.template emplace<NullParser>();
+            status_ = Status::null_val;
+            break;
+        case ValueStart::true_val:
+            scalar_.template emplace<TrueParser>();
+            status_ = Status::true_val;
+            break;
+        case ValueStart::false_val:
+            scalar_.template emplace<FalseParser>();
+            status_ = Status::false_val;
+            break;
+        default:
+            return ParseResult::error;
+    }
+    return ParseResult::ok;
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult StackParser<Consumer>::parse(const char*& p, const char* end) {
+    JSON_TRACE_SCOPE(p);
+    ParseResult r = run(p, end);
+    return JSON_TRACE_RESULT(r, p);
+}
+
+template<typename Consumer>
+REQUIRES(StackConsumerConcept<Consumer>)
+ParseResult StackParser<Consumer>::run(const char*& p, const char* end) {
+    while (p != end) {
+        ParseResult r = ParseResult::ok;
+        switch (status_) {
+            case Status::value:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                r = begin_value(p);
+                break;
+            case Status::object_first:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                if (*p == '}') {
+                    ++p;
+                    close();
+                    break;
+                }
+                [[fallthrough]];
+            case Status::object_key:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                {
+                    KeyValueConsumer& kv = *stack_.back().object;
+                    scalar_.template emplace<KeyParser>(kv.key_consumer(), true);
+                }
+                status_ = Status::key;
+                break;
+            case Status::key:
+                r = std::get<KeyParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok)
+                    status_ = Status::colon;
+                break;
+            case Status::colon:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                if (*p != ':')
+                    return ParseResult::error;
+                ++p;
+                status_ = Status::value;
+                break;
+            case Status::object_next:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                if (*p == ',') {
+                    ++p;
+                    status_ = Status::object_key;
+                } else if (*p == '}') {
+                    ++p;
+                    close();
+                } else
+                    return ParseResult::error;
+                break;
+            case Status::array_first:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                if (*p == ']') {
+                    ++p;
+                    close();
+                } else
+                    status_ = Status::value;
+                break;
+            case Status::array_next:
+                if (wsp_.parse(p, end) != ParseResult::ok)
+                    return ParseResult::partial;
+                if (*p == ',') {
+                    ++p;
+                    status_ = Status::value;
+                } else if (*p == ']') {
+                    ++p;
+                    close();
+                } else
+                    return ParseResult::error;
+                break;
+            case Status::string:
+                r = std::get<StringValueParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok)
+                    end_value();
+                break;
+            case Status::number:
+                r = std::get<NumberValueParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok)
+                    end_value();
+                break;
+            case Status::null_val:
+                r = std::get<NullParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok) {
+                    value_consumer().set_null();
+                    end_value();
+                }
+                break;
+            case Status::true_val:
+                r = std::get<TrueParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok) {
+                    value_consumer().set_bool(true);
+                    end_value();
+                }
+                break;
+            case Status::false_val:
+                r = std::get<FalseParser>(scalar_).parse(p, end);
+                if (r == ParseResult::ok) {
+                    value_consumer().set_bool(false);
+                    end_value();
+                }
+                break;
+            case Status::done:
+                return ParseResult::ok;
+        }
+        if (r == ParseResult::error)
+            return r;
+        if (status_ == Status::done)
+            return ParseResult::ok;
+    }
+    return status_ == Status::done ? ParseResult::ok : ParseResult::partial;
+}
+
+} // namespace libacpp::json
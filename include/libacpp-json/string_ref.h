@@ -0,0 +1,84 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "parser.h"
+
+namespace libacpp::json {
+
+// Collects the decoded content of a string.
+template <typename String>
+class UnescapeConsumer {
+public:
+    explicit UnescapeConsumer(String& out): out_(out) {}
+
+    void string_begin() { out_.clear(); }
+    void add_char_string(char c) { out_.push_back(c); }
+    void add_chars_string(std::string_view s) { out_.append(s); }
+    void string_end() {}
+
+private:
+    String& out_;
+};
+
+// Decodes the escapes of the content of a string (the bytes between its
+// quotes) into out. Returns false when an escape is malformed.
+template <typename String>
+bool unescape(std::string_view raw, String& out) {
+    UnescapeConsumer<String> consumer(out);
+    StringParser<UnescapeConsumer<String>, false> sp(consumer);
+    return sp.parse_content(raw) == ParseResult::ok;
+}
+
+// A string value that points into the parsed buffer instead of owning its
+// bytes: the buffer must outlive it (and every copy of it). Strings without
+// escapes are used as they are; escaped ones are decoded the first time
+// they are read and the result is kept, shared between copies and
+// allocated from the given resource (the document's arena). Reading is
+// not synchronized: share a JsonStringRef across threads only once it has
+// been decoded.
+class JsonStringRef {
+public:
+    JsonStringRef() = default;
+    JsonStringRef(std::string_view raw, bool escaped,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    :raw_(raw), escaped_(escaped), resource_(resource) {}
+
+    // the bytes as they are in the buffer, escapes included
+    std::string_view raw() const { return raw_; }
+    bool escaped() const { return escaped_; }
+
+    std::string_view view() const {
+        if (!escaped_)
+            return raw_;
+        if (!decoded_) {
+            std::pmr::polymorphic_allocator<std::pmr::string> alloc(resource_);
+            auto decoded = std::allocate_shared<std::pmr::string>(alloc);
+            unescape(raw_, *decoded);
+            decoded_ = std::move(decoded);
+        }
+        return *decoded_;
+    }
+
+    std::string str() const { return std::string(view()); }
+
+    bool operator==(const JsonStringRef& other) const { return view() == other.view(); }
+    bool operator==(std::string_view other) const { return view() == other; }
+
+private:
+    std::string_view raw_;
+    bool escaped_ = false;
+    std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+    mutable std::shared_ptr<const std::pmr::string> decoded_;
+};
+
+} // namespace libacpp::json
@@ -0,0 +1,60 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace libacpp::json {
+
+namespace simd {
+
+// Stage 1 kernels: write to out the offset of every structural position of
+// [begin, end): the brackets, ':' and ',' outside strings, the opening quote
+// of every string and the first byte of every other scalar (number or
+// literal). Returns one past the last offset written, or nullptr when the
+// input ends inside a string. out must have room for
+// (end - begin) + structurals_padding offsets: the kernels may write a few
+// garbage ones past the returned position. All variants give the same
+// result.
+inline constexpr size_t structurals_padding = 64;
+
+uint32_t* find_structurals_scalar(const char* begin, const char* end, uint32_t* out);
+uint32_t* find_structurals_sse2(const char* begin, const char* end, uint32_t* out);
+uint32_t* find_structurals_avx2(const char* begin, const char* end, uint32_t* out);
+
+using find_structurals_fn = uint32_t* (*)(const char* begin, const char* end, uint32_t* out);
+find_structurals_fn find_structurals_kernel();
+const char* find_structurals_kernel_name();
+
+} // namespace simd
+
+
+// Positions of the structural bytes of a whole buffer (see
+// simd::find_structurals_scalar), followed by a sentinel holding the buffer
+// size. The storage is kept between builds, so reusing an index for a
+// stream of documents does not allocate once it has grown.
+class StructuralIndex {
+public:
+    enum class Result {ok, open_string, too_large};
+
+    Result build(const char* begin, const char* end);
+
+    const uint32_t* begin() const { return positions_.get(); }
+    // one past the sentinel
+    const uint32_t* end() const { return positions_.get() + size_; }
+    size_t size() const { return size_; }
+    uint32_t operator[](size_t i) const { return positions_[i]; }
+
+private:
+    std::unique_ptr<uint32_t[]> positions_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace libacpp::json
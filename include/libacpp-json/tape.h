@@ -0,0 +1,274 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "consumer.h"
+
+namespace libacpp::json {
+
+// A document as one contiguous array of 64 bit words, in document order.
+// Each word holds a type tag in its top byte and a 56 bit payload:
+//
+//   null_val, true_val, false_val   no payload
+//   int64, uint64, double_val       the value in the next word
+//   short_string                    length (low byte) and up to 6 bytes
+//   string                          offset of the string in strings()
+//                                   (a 32 bit length, then the bytes)
+//   object_begin, array_begin       index of the matching end word (low
+//                                   32 bits) and number of members or
+//                                   elements (upper 24 bits, saturated)
+//   object_end, array_end           index of the matching begin word
+//
+// Object members are a key (a string word) followed by the value. Skipping
+// any value is O(1), so lookups and iteration only touch the words of the
+// level they walk.
+//
+// Limits: a tape holds up to Tape::max_index + 1 words (about 32 GiB) and
+// a string up to Tape::max_string_length bytes (4 GiB). TapeConsumer
+// reports a document past them with failed().
+enum class TapeType : uint8_t {
+    null_val = 'n', true_val = 't', false_val = 'f',
+    int64 = 'l', uint64 = 'u', double_val = 'd',
+    string = '"', short_string = 's',
+    object_begin = '{', object_end = '}', array_begin = '[', array_end = ']',
+};
+
+class TapeRef;
+
+class Tape {
+public:
+    static constexpr size_t short_string_max = 6;
+    static constexpr uint64_t payload_mask = (uint64_t{1} << 56) - 1;
+    static constexpr uint32_t max_count = (1u << 24) - 1;
+    static constexpr size_t max_index = UINT32_MAX;
+    static constexpr size_t max_string_length = UINT32_MAX;
+
+    static TapeType type(uint64_t word) { return static_cast<TapeType>(word >> 56); }
+    static uint64_t payload(uint64_t word) { return word & payload_mask; }
+    static uint64_t word(TapeType type, uint64_t payload) {
+        return (static_cast<uint64_t>(type) << 56) | (payload & payload_mask);
+    }
+
+    const std::vector<uint64_t>& words() const { return words_; }
+    const std::string& strings() const { return strings_; }
+    bool empty() const { return words_.empty(); }
+    void clear() { words_.clear(); strings_.clear(); }
+
+    // the document; the tape must not be empty
+    TapeRef root() const;
+
+private:
+    friend class TapeConsumer;
+
+    std::vector<uint64_t> words_;
+    std::string strings_;
+};
+
+class TapeArrayIterator;
+class TapeObjectIterator;
+
+template <typename Iterator>
+struct TapeRange {
+    Iterator first;
+    Iterator last;
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+};
+
+// One value of a tape. Cheap to copy; valid while the tape is not changed.
+class TapeRef {
+public:
+    TapeRef(const Tape& tape, size_t index): tape_(&tape), index_(index) {}
+
+    TapeType type() const { return Tape::type(word()); }
+    size_t index() const { return index_; }
+    // index one past the value (and its subtree): O(1)
+    size_t end_index() const;
+
+    bool is_null() const { return type() == TapeType::null_val; }
+    bool is_bool() const { return type() == TapeType::true_val || type() == TapeType::false_val; }
+    bool is_number() const {
+        return type() == TapeType::int64 || type() == TapeType::uint64 || type() == TapeType::double_val;
+    }
+    bool is_string() const { return type() == TapeType::string || type() == TapeType::short_string; }
+    bool is_object() const { return type() == TapeType::object_begin; }
+    bool is_array() const { return type() == TapeType::array_begin; }
+
+    bool get_bool() const { return type() == TapeType::true_val; }
+    int64_t get_int64() const { return std::bit_cast<int64_t>(next_word()); }
+    uint64_t get_uint64() const { return next_word(); }
+    // any number, converted
+    double get_double() const;
+    std::string_view get_string() const;
+
+    // members of an object or elements of an array: O(1) below
+    // Tape::max_count. Members with the same key all count.
+    size_t size() const;
+
+    TapeRange<TapeArrayIterator> elements() const;
+    TapeRange<TapeObjectIterator> members() const;
+
+    // linear scans of one level, skipping the subtrees; find() returns the
+    // last member with the key
+    std::optional<TapeRef> find(std::string_view key) const;
+    std::optional<TapeRef> at(size_t i) const;
+
+private:
+    uint64_t word() const { return tape_->words()[index_]; }
+    uint64_t next_word() const { return tape_->words()[index_ + 1]; }
+
+    const Tape* tape_;
+    size_t index_;
+};
+
+inline TapeRef Tape::root() const { return TapeRef(*this, 0); }
+
+class TapeArrayIterator {
+public:
+    using value_type = TapeRef;
+    using difference_type = std::ptrdiff_t;
+
+    TapeArrayIterator() = default;
+    TapeArrayIterator(const Tape& tape, size_t index): tape_(&tape), index_(index) {}
+
+    TapeRef operator*() const { return TapeRef(*tape_, index_); }
+    TapeArrayIterator& operator++() { index_ = TapeRef(*tape_, index_).end_index(); return *this; }
+    TapeArrayIterator operator++(int) { auto old = *this; ++*this; return old; }
+    bool operator==(const TapeArrayIterator& other) const { return index_ == other.index_; }
+
+private:
+    const Tape* tape_ = nullptr;
+    size_t index_ = 0;
+};
+
+struct TapeMember {
+    std::string_view key;
+    TapeRef value;
+};
+
+class TapeObjectIterator {
+public:
+    using value_type = TapeMember;
+    using difference_type = std::ptrdiff_t;
+
+    TapeObjectIterator() = default;
+    TapeObjectIterator(const Tape& tape, size_t index): tape_(&tape), index_(index) {}
+
+    TapeMember operator*() const {
+        TapeRef key(*tape_, index_);
+        return {key.get_string(), TapeRef(*tape_, key.end_index())};
+    }
+    TapeObjectIterator& operator++() {
+        index_ = TapeRef(*tape_, TapeRef(*tape_, index_).end_index()).end_index();
+        return *this;
+    }
+    TapeObjectIterator operator++(int) { auto old = *this; ++*this; return old; }
+    bool operator==(const TapeObjectIterator& other) const { return index_ == other.index_; }
+
+private:
+    const Tape* tape_ = nullptr;
+    size_t index_ = 0;
+};
+
+
+// Builds a Tape from the parser events; usable with ValueParser,
+// StackParser and IndexedParser. Numbers arrive as values
+// (NumberValueConsumerConcept); whole strings are copied straight from the
+// input (StringRawConsumerConcept).
+class TapeConsumer {
+public:
+    explicit TapeConsumer(Tape& tape): tape_(tape) {}
+
+    // empties the tape for the next document
+    void reset();
+
+    // The document went past the limits of the tape, which is then not
+    // usable: the parse itself still succeeds.
+    bool failed() const { return failed_; }
+
+    // Begin String Consumer
+    void string_begin() { begin_string(); }
+    void add_char_string(char c) { tape_.strings_.push_back(c); }
+    void add_chars_string(std::string_view s) { tape_.strings_.append(s); }
+    void string_end() { end_string(false); }
+    void string_raw(std::string_view raw, bool escaped);
+    // End String Consumer
+
+    // Begin Key Consumer
+    void key_begin() { string_begin(); }
+    void add_char_key(char c) { add_char_string(c); }
+    void add_chars_key(std::string_view s) { add_chars_string(s); }
+    void key_end() { end_string(true); }
+    void key_raw(std::string_view raw, bool escaped);
+    // End Key Consumer
+
+    void number_value(int64_t v);
+    void number_value(uint64_t v);
+    void number_value(double v);
+
+    void set_bool(bool v);
+    void set_null();
+
+    void object_begin() { open(TapeType::object_begin); }
+    void object_end() { close(TapeType::object_end); }
+    void array_begin() { open(TapeType::array_begin); }
+    void array_end() { close(TapeType::array_end); }
+
+    typedef TapeConsumer KeyConsumerType;
+    typedef TapeConsumer ValueConsumerType;
+    typedef TapeConsumer KeyValueConsumerType;
+    typedef TapeConsumer NumberConsumerType;
+    typedef TapeConsumer StringConsumerType;
+    typedef TapeConsumer ObjectConsumerType;
+    typedef TapeConsumer ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+
+    Tape& tape() { return tape_; }
+
+private:
+    // an open container: its begin word and its number of values
+    struct Open {
+        size_t begin;
+        uint32_t count;
+    };
+
+    void value_added();
+    void open(TapeType type);
+    void close(TapeType type);
+    void begin_string();
+    void end_string(bool is_key);
+    void push(TapeType type, uint64_t payload) { tape_.words_.push_back(Tape::word(type, payload)); }
+
+    Tape& tape_;
+    std::vector<Open> open_;
+    size_t string_start_ = 0;  // where the string being built starts in strings()
+    bool failed_ = false;
+};
+
+
+// Conversions to and from the JsonValue DOM. Numbers keep their type; lazy
+// JsonRawNumber values are converted on the way to the tape.
+JsonValue to_json_value(const TapeRef& value, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+void to_tape(const JsonValue& value, Tape& tape);
+
+} // namespace libacpp::json
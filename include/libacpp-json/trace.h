@@ -0,0 +1,160 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "parse_result.h"
+
+namespace libacpp::json {
+
+// Instrumentation of the parsers, chosen at compile time. Unless
+// ACPPJSON_TRACE is defined the JSON_TRACE_* macros expand to nothing and
+// the parsers are the same code as without them. With it, every thread
+// records counters and the last events of its parsers in its recorder():
+// plain stores, nothing is formatted or written while parsing.
+//
+// ACPPJSON_TRACE must be the same in every translation unit that
+// instantiates a given parser (the ACPPJSON_TRACE CMake option defines it
+// for the library and everything linked to it).
+namespace trace {
+
+enum class Event : uint8_t {
+    ok,             // an outermost parse call completed a value; value: bytes consumed
+    partial,        // it ran out of input; value: bytes consumed
+    error,          // it failed; value: bytes consumed up to the error
+    escape,         // backslash escapes in a string or key; value: how many
+    container_begin,// an object or array opened; value: the new depth
+    container_end,  // it closed; value: the depth left
+};
+
+struct Counters {
+    uint64_t bytes = 0;         // consumed by the outermost parse calls
+    uint64_t calls = 0;         // outermost parse calls
+    uint64_t partials = 0;      // of them returning partial
+    uint64_t errors = 0;        // of them returning error
+    uint64_t escapes = 0;
+    uint64_t containers = 0;
+    uint32_t depth = 0;         // open containers now
+    uint32_t max_depth = 0;     // high-water mark of depth
+};
+
+struct Record {
+    Event event;
+    uint64_t value;
+};
+
+// Counters and a ring of the last history_size events of one thread.
+class Recorder {
+public:
+    static constexpr size_t history_size = 64;
+
+    const Counters& counters() const { return counters_; }
+    // the recorded events still in the ring, oldest first
+    std::vector<Record> history() const;
+    void reset() { *this = Recorder(); }
+
+    void record(Event event, uint64_t value = 0) {
+        switch (event) {
+            case Event::escape:
+                counters_.escapes += value;
+                break;
+            case Event::container_begin:
+                ++counters_.containers;
+                value = ++counters_.depth;
+                if (counters_.depth > counters_.max_depth)
+                    counters_.max_depth = counters_.depth;
+                break;
+            case Event::container_end:
+                value = --counters_.depth;
+                break;
+            default:
+                break;
+        }
+        history_[next_++ % history_size] = Record{event, value};
+    }
+
+    // Parse calls nest (ValueParser runs its children through their own
+    // parse()); only the outermost ones are counted.
+    bool enter() { return nesting_++ == 0; }
+    void leave() { --nesting_; }
+    void parsed(ParseResult r, uint64_t bytes) {
+        counters_.bytes += bytes;
+        ++counters_.calls;
+        if (r == ParseResult::partial) {
+            ++counters_.partials;
+            record(Event::partial, bytes);
+        } else if (r == ParseResult::error) {
+            ++counters_.errors;
+            // the containers left open will not be closed
+            counters_.depth = 0;
+            record(Event::error, bytes);
+        } else {
+            record(Event::ok, bytes);
+        }
+    }
+
+private:
+    Counters counters_;
+    std::array<Record, history_size> history_{};
+    uint64_t next_ = 0;
+    uint32_t nesting_ = 0;
+};
+
+// the recorder of the calling thread
+inline Recorder& recorder() {
+    thread_local Recorder r;
+    return r;
+}
+
+// Accounts one parse call from where its input began.
+class Scope {
+public:
+    explicit Scope(const char* begin): begin_(begin), outer_(recorder().enter()) {}
+    ~Scope() { recorder().leave(); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ParseResult result(ParseResult r, const char* p) {
+        if (outer_)
+            recorder().parsed(r, static_cast<uint64_t>(p - begin_));
+        return r;
+    }
+
+private:
+    const char* begin_;
+    bool outer_;
+};
+
+inline std::vector<Record> Recorder::history() const {
+    std::vector<Record> records;
+    const uint64_t first = next_ > history_size ? next_ - history_size : 0;
+    for (uint64_t i = first; i < next_; ++i)
+        records.push_back(history_[i % history_size]);
+    return records;
+}
+
+} // namespace trace
+
+} // namespace libacpp::json
+
+#if defined(ACPPJSON_TRACE)
+    // at the top of a parse(): p is where its input begins
+    #define JSON_TRACE_SCOPE(p) ::libacpp::json::trace::Scope json_trace_scope_(p)
+    // the value to return, r, with p where parsing stopped
+    #define JSON_TRACE_RESULT(r, p) json_trace_scope_.result(r, p)
+    #define JSON_TRACE_EVENT(event, ...) \
+        ::libacpp::json::trace::recorder().record(::libacpp::json::trace::Event::event __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define JSON_TRACE_SCOPE(p) ((void)0)
+    #define JSON_TRACE_RESULT(r, p) (r)
+    #define JSON_TRACE_EVENT(event, ...) ((void)0)
+#endif
@@ -0,0 +1,209 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libacpp::json {
+
+// Output of the writers: one contiguous buffer that grows as needed and is
+// kept between documents (clear() keeps the capacity). Built on a file
+// descriptor, it is written out whenever it holds flush_size bytes, so
+// memory stays bounded whatever the size of the output.
+class WriteBuffer {
+public:
+    static constexpr size_t default_flush_size = 64 << 10;
+
+    WriteBuffer() = default;
+    explicit WriteBuffer(int fd, size_t flush_size = default_flush_size): fd_(fd), flush_size_(flush_size) {}
+    ~WriteBuffer() { flush(); }
+
+    WriteBuffer(const WriteBuffer&) = delete;
+    WriteBuffer& operator=(const WriteBuffer&) = delete;
+
+    // Room for n more bytes: write them at the returned position, then
+    // commit() the number written.
+    char* reserve(size_t n) {
+        if (capacity_ - size_ < n)
+            make_room(n);
+        return data_.get() + size_;
+    }
+    void commit(size_t n) { size_ += n; }
+
+    void push_back(char c) { *reserve(1) = c; ++size_; }
+    void append(std::string_view s) {
+        std::memcpy(reserve(s.size()), s.data(), s.size());
+        size_ += s.size();
+    }
+    void append(size_t n, char c) {
+        std::memset(reserve(n), c, n);
+        size_ += n;
+    }
+
+    // what has not been flushed yet
+    const char* data() const { return data_.get(); }
+    size_t size() const { return size_; }
+    std::string_view view() const { return {data_.get(), size_}; }
+    std::string str() const { return std::string(view()); }
+    void clear() { size_ = 0; }
+
+    // Writes the buffer to the file descriptor, if any, and empties it.
+    // Returns false (and failed() turns true) when the write fails.
+    bool flush();
+    bool failed() const { return failed_; }
+    int fd() const { return fd_; }
+
+private:
+    void make_room(size_t n);
+
+    std::unique_ptr<char[]> data_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    int fd_ = -1;
+    size_t flush_size_ = default_flush_size;
+    bool failed_ = false;
+};
+
+enum class JsonFormat {compact, pretty};
+
+// The pieces of JSON text, appended to out.
+namespace write {
+
+// s in quotes, escaping '"', '\\' and the control characters; the bytes
+// that need no escape (found with simd::find_string_special) are copied in
+// runs.
+void string(WriteBuffer& out, std::string_view s);
+// the same without the quotes
+void string_content(WriteBuffer& out, std::string_view s);
+void number(WriteBuffer& out, int64_t v);
+void number(WriteBuffer& out, uint64_t v);
+// Shortest text that reads back as the same double; integral values keep a
+// ".0" so they read back as doubles. Infinities and NaN, which JSON cannot
+// represent, are written as null.
+void number(WriteBuffer& out, double v);
+
+} // namespace write
+
+
+// Writes JSON from a stream of events, without building a document. The
+// events are those of the consumer concepts of parser.h, so a JsonWriter
+// can be given to any of the parsers to re-serialize its input (compacting
+// or pretty printing it); a consumer in between can drop or rewrite
+// events to filter it. Strings and numbers the parser delivers whole are
+// copied through as they are, escapes and digits included.
+//
+// Memory is the output buffer (bounded when it flushes to a file) plus one
+// byte per open container. The events are not validated: they must form
+// one JSON value, as the parsers guarantee.
+class JsonWriter {
+public:
+    explicit JsonWriter(WriteBuffer& out, JsonFormat format = JsonFormat::compact): out_(out), format_(format) {}
+
+    // Direct use
+    void key(std::string_view k) { key_begin(); write::string_content(out_, k); key_end(); }
+    void string(std::string_view s) { string_begin(); write::string_content(out_, s); string_end(); }
+    void number(int64_t v) { number_value(v); }
+    void number(uint64_t v) { number_value(v); }
+    void number(double v) { number_value(v); }
+    void boolean(bool v) { set_bool(v); }
+    void null() { set_null(); }
+
+    // Begin String Consumer
+    void string_begin() { value_begin(); out_.push_back('"'); }
+    void add_char_string(char c) { write::string_content(out_, std::string_view(&c, 1)); }
+    void add_chars_string(std::string_view s) { write::string_content(out_, s); }
+    void string_end() { out_.push_back('"'); }
+    // the escapes of raw are valid JSON as they are
+    void string_raw(std::string_view raw, bool) {
+        value_begin();
+        quoted(raw);
+    }
+    // End String Consumer
+
+    // Begin Key Consumer
+    void key_begin() { separator(); out_.push_back('"'); }
+    void add_char_key(char c) { add_char_string(c); }
+    void add_chars_key(std::string_view s) { add_chars_string(s); }
+    void key_end();
+    void key_raw(std::string_view raw, bool) {
+        separator();
+        quoted(raw);
+        colon();
+    }
+    // End Key Consumer
+
+    void number_value(int64_t v) { value_begin(); write::number(out_, v); }
+    void number_value(uint64_t v) { value_begin(); write::number(out_, v); }
+    void number_value(double v) { value_begin(); write::number(out_, v); }
+    // the number as it was in the input
+    bool number_raw(std::string_view text) { value_begin(); out_.append(text); return true; }
+
+    void set_bool(bool v) { value_begin(); out_.append(v ? "true" : "false"); }
+    void set_null() { value_begin(); out_.append("null"); }
+
+    void object_begin() { open('{'); }
+    void object_end() { close('}'); }
+    void array_begin() { open('['); }
+    void array_end() { close(']'); }
+
+    typedef JsonWriter KeyConsumerType;
+    typedef JsonWriter ValueConsumerType;
+    typedef JsonWriter KeyValueConsumerType;
+    typedef JsonWriter NumberConsumerType;
+    typedef JsonWriter StringConsumerType;
+    typedef JsonWriter ObjectConsumerType;
+    typedef JsonWriter ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+
+    // open containers
+    size_t depth() const { return open_.size(); }
+    // Gets ready for the next value, after a complete one or an error.
+    void reset() { open_.clear(); first_ = true; after_key_ = false; }
+
+    WriteBuffer& buffer() { return out_; }
+
+private:
+    // before a value: the comma (and new line) unless it follows a key
+    void value_begin() {
+        if (after_key_)
+            after_key_ = false;
+        else
+            separator();
+    }
+    void separator();
+    void open(char c);
+    void close(char c);
+    void new_line(size_t depth);
+    // after the closing quote of a key
+    void colon();
+    void quoted(std::string_view content) {
+        char* w = out_.reserve(content.size() + 2);
+        w[0] = '"';
+        std::memcpy(w + 1, content.data(), content.size());
+        w[content.size() + 1] = '"';
+        out_.commit(content.size() + 2);
+    }
+
+    WriteBuffer& out_;
+    JsonFormat format_;
+    std::vector<char> open_;    // '{' or '[' of each open container
+    bool first_ = true;         // nothing written yet in the innermost container
+    bool after_key_ = false;
+};
+
+} // namespace libacpp::json
@@ -0,0 +1,105 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <bit>
+#include <new>
+
+#include <libacpp-json/arena.h>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #define ACPPJSON_HUGE_PAGES 1
+#endif
+
+namespace libacpp::json {
+
+namespace {
+
+#if defined(ACPPJSON_HUGE_PAGES)
+
+class HugePageResource: public std::pmr::memory_resource {
+public:
+    static constexpr size_t huge_page = 2 << 20;
+
+private:
+    static size_t round_up(size_t bytes) { return (bytes + huge_page - 1) & ~(huge_page - 1); }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > huge_page)
+            throw std::bad_alloc();
+        // over allocate to align the block on a huge page boundary
+        size_t size = round_up(bytes);
+        void* p = mmap(nullptr, size + huge_page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        char* base = static_cast<char*>(p);
+        char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(base)));
+        if (aligned != base)
+            munmap(base, static_cast<size_t>(aligned - base));
+        char* tail = aligned + size;
+        size_t tail_size = static_cast<size_t>(base + size + huge_page - tail);
+        if (tail_size != 0)
+            munmap(tail, tail_size);
+        madvise(aligned, size, MADV_HUGEPAGE);
+        return aligned;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t) override {
+        munmap(p, round_up(bytes));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+#endif
+
+} // namespace
+
+std::pmr::memory_resource* huge_page_resource() {
+#if defined(ACPPJSON_HUGE_PAGES)
+    static HugePageResource resource;
+    return &resource;
+#else
+    return std::pmr::get_default_resource();
+#endif
+}
+
+
+JsonArena::JsonArena(size_t block_size, bool huge_pages)
+:huge_pages_(huge_pages),
+upstream_(huge_pages ? huge_page_resource() : std::pmr::get_default_resource()) {
+    allocate_block(block_size);
+}
+
+JsonArena::~JsonArena() {
+    monotonic_.reset();
+    upstream_->deallocate(block_, block_size_, alignof(std::max_align_t));
+}
+
+void JsonArena::allocate_block(size_t size) {
+    block_ = upstream_->allocate(size, alignof(std::max_align_t));
+    block_size_ = size;
+    monotonic_.emplace(block_, block_size_, upstream_);
+}
+
+void JsonArena::release() {
+    monotonic_.reset(); // gives back the blocks past the first one
+    if (used_ > block_size_) {
+        // the last document did not fit: keep room for it next time
+        upstream_->deallocate(block_, block_size_, alignof(std::max_align_t));
+        allocate_block(std::bit_ceil(used_ + used_ / 8));
+    } else {
+        monotonic_.emplace(block_, block_size_, upstream_);
+    }
+    used_ = 0;
+}
+
+void* JsonArena::do_allocate(size_t bytes, size_t alignment) {
+    used_ += bytes;
+    return monotonic_->allocate(bytes, alignment);
+}
+
+} // namespace libacpp::json
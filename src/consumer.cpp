@@ -1,3 +1,57 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
 #include <libacpp-json/consumer.h>
 
+namespace libacpp::json {
+
+namespace {
+
+void write_value(const JsonValue& value, JsonWriter& writer) {
+    std::visit([&](auto&& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            writer.boolean(v);
+        } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, double>) {
+            writer.number(v);
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            writer.null();
+        } else if constexpr (std::is_same_v<T, JsonString>) {
+            writer.string(v);
+        } else if constexpr (std::is_same_v<T, JsonStringRef>) {
+            writer.string_raw(v.raw(), v.escaped()); // still escaped as in the input
+        } else if constexpr (std::is_same_v<T, JsonRawNumber>) {
+            writer.number_raw(v.text());
+        } else if constexpr (std::is_same_v<T, JsonObject>) {
+            writer.object_begin();
+            for (const auto& [key, member]: v) {
+                writer.key(key.view());
+                write_value(member, writer);
+            }
+            writer.object_end();
+        } else if constexpr (std::is_same_v<T, JsonArray>) {
+            writer.array_begin();
+            for (const auto& element: v)
+                write_value(element, writer);
+            writer.array_end();
+        }
+    }, static_cast<const JsonValue::variant_type&>(value));
+}
+
+} // namespace
+
+void write_json(const JsonValue& value, WriteBuffer& out, JsonFormat format) {
+    JsonWriter writer(out, format);
+    write_value(value, writer);
+}
+
+std::string to_json(const JsonValue& value, JsonFormat format) {
+    WriteBuffer out;
+    write_json(value, out, format);
+    return out.str();
+}
 
+} // namespace libacpp::json
@@ -0,0 +1,29 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <libacpp-json/key_table.h>
+
+namespace libacpp::json {
+
+const KeyTable::Symbol* KeyTable::intern(std::string_view key) {
+    auto it = index_.find(key);
+    if (it != index_.end())
+        return it->second;
+    if (symbols_.size() >= max_size_)
+        return nullptr;
+    const size_t hash = std::hash<std::string_view>{}(key);
+    // the index keys view the names of the symbols, which never move
+    Symbol& symbol = symbols_.emplace_back(Symbol{std::string(key), hash, static_cast<uint32_t>(symbols_.size()), this});
+    index_.emplace(std::string_view(symbol.name), &symbol);
+    return &symbol;
+}
+
+const KeyTable::Symbol* KeyTable::find(std::string_view key) const {
+    auto it = index_.find(key);
+    return it == index_.end() ? nullptr : it->second;
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,232 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <cstring>
+#include <iterator>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parallel.h>
+#include <libacpp-json/simd.h>
+
+namespace libacpp::json {
+
+namespace {
+
+// a byte that starts an element of the same type as one starting with first
+bool starts_like(char c, char first) {
+    switch (first) {
+        case '{': case '[': case '"':
+            return c == first;
+        default:
+            return c != '{' && c != '[' && c != '"' && c != ',' && c != ']';
+    }
+}
+
+// the byte before p, last of an element of the same type as one starting
+// with first; begin is where the array opened
+bool ends_like(const char* begin, const char* p, char first) {
+    const char c = p[-1];
+    switch (first) {
+        case '{':
+            return c == '}';
+        case '[':
+            return c == ']';
+        case '"': {
+            if (c != '"')
+                return false;
+            // the quote is escaped after an odd run of backslashes
+            const char* q = p - 1;
+            while (q != begin && q[-1] == '\\')
+                --q;
+            return (p - 1 - q) % 2 == 0;
+        }
+        default:
+            return c != '}' && c != ']' && c != '"' && c != ',' && c != '[';
+    }
+}
+
+// The first comma in [p, limit) that looks like the split between two
+// elements of the outermost array, opened at begin and closed at close;
+// nullptr when there is none.
+const char* guess_split(const char* begin, const char* p, const char* limit, const char* close, char first) {
+    while (p != limit) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(limit - p)));
+        if (!comma)
+            return nullptr;
+        const char* prev = comma;
+        while (prev != begin + 1 && simd::is_whitespace(prev[-1]))
+            --prev;
+        const char* next = simd::skip_whitespace(comma + 1, close);
+        if (prev != begin + 1 && next != close && ends_like(begin, prev, first) && starts_like(*next, first))
+            return comma;
+        p = comma + 1;
+    }
+    return nullptr;
+}
+
+// Parses the element after the delimiter ('[' or ',') at p into the array
+// consumer is in. close is the last byte of the array, so a number at the
+// end of the range is terminated. On return p is at the next delimiter.
+bool parse_element(ValueParser<JsonConsumer>& parser, const char*& p, const char* close) {
+    p = simd::skip_whitespace(p + 1, close);
+    parser.reset();
+    if (parser.parse(p, close + 1) != ParseResult::ok)
+        return false;
+    p = simd::skip_whitespace(p, close);
+    return p == close || *p == ',';
+}
+
+// the elements from the delimiter at begin to the one at end
+bool parse_range(JsonConsumer& consumer, const char* begin, const char* end, const char* close) {
+    ValueParser<JsonConsumer> parser(consumer);
+    const char* p = begin;
+    while (p != end) {
+        if (!parse_element(parser, p, close) || p > end)
+            return false;
+    }
+    return true;
+}
+
+ParseResult parse_sequential(std::string_view json, JsonConsumer& consumer) {
+    consumer.reset();
+    ValueParser<JsonConsumer> parser(consumer);
+    const char* end = json.data() + json.size();
+    const char* p = simd::skip_whitespace(json.data(), end);
+    ParseResult r = parser.parse(p, end);
+    if (r == ParseResult::partial) {
+        // a number at the end of the input
+        const char* space = " ";
+        r = parser.parse(space, space + 1);
+    }
+    if (r == ParseResult::ok && simd::skip_whitespace(p, end) != end)
+        r = ParseResult::error;
+    return r == ParseResult::partial ? ParseResult::error : r;
+}
+
+} // namespace
+
+std::vector<std::string_view> split_lines(std::string_view lines, size_t slice_size) {
+    std::vector<std::string_view> slices;
+    slice_size = std::max<size_t>(slice_size, 1);
+    const char* p = lines.data();
+    const char* end = p + lines.size();
+    while (p != end) {
+        // the slice ends with the first line break from its nominal last byte
+        const char* cut = end;
+        if (static_cast<size_t>(end - p) > slice_size) {
+            cut = simd::find_newline(p + slice_size - 1, end);
+            if (cut != end)
+                ++cut;
+        }
+        slices.emplace_back(p, static_cast<size_t>(cut - p));
+        p = cut;
+    }
+    return slices;
+}
+
+ParallelArrayResult parse_array_parallel(std::string_view json, JsonConsumer& consumer, ParallelOptions options) {
+    ParallelArrayResult result;
+    const size_t slice_size = std::max<size_t>(options.slice_size, 1);
+    const char* end = json.data() + json.size();
+    const char* open = simd::skip_whitespace(json.data(), end);
+    const char* close = end;
+    while (close != open && simd::is_whitespace(close[-1]))
+        --close;
+    const char* first = nullptr;
+    if (close - open >= 2 && *open == '[' && close[-1] == ']')
+        first = simd::skip_whitespace(open + 1, --close);
+    if (!first || first == close || json.size() <= slice_size
+            || consumer.resource() != std::pmr::get_default_resource()) {
+        result.result = parse_sequential(json, consumer);
+        result.sequential = true;
+        return result;
+    }
+
+    // the delimiters the ranges begin at, each range ending where the next
+    // one begins or at close
+    std::vector<const char*> splits{open};
+    for (const char* q = open + slice_size; q < close; q += slice_size) {
+        const char* from = std::max(q, splits.back() + 1);
+        if (from >= close)
+            break;
+        const char* split = guess_split(open, from, std::min(q + slice_size, close), close, *first);
+        if (split)
+            splits.push_back(split);
+    }
+    const size_t ranges = splits.size();
+    auto range_end = [&](size_t i) { return i + 1 < ranges ? splits[i + 1] : close; };
+
+    // the ranges, taken in order by the threads and the calling one
+    std::vector<JsonArray> arrays(ranges);
+    std::unique_ptr<bool[]> parsed(new bool[ranges]());
+    std::atomic<size_t> next{0};
+    if (options.threads == 0)
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t n = std::min(options.threads, ranges);
+    std::vector<std::exception_ptr> errors(n);
+    auto run = [&](size_t t) {
+        try {
+            JsonConsumer worker(consumer.strings());
+            worker.set_lazy_numbers(consumer.lazy_numbers());
+            for (size_t i = next++; i < ranges; i = next++) {
+                worker.reset();
+                worker.array_begin();
+                parsed[i] = parse_range(worker, splits[i], range_end(i), close);
+                worker.array_end();
+                arrays[i] = std::move(std::get<JsonArray>(worker.root()));
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+            next = ranges;
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(n - 1);
+    try {
+        for (size_t t = 1; t < n; ++t)
+            threads.emplace_back(run, t);
+    } catch (...) {
+        // the threads started use the locals: stop and join them first
+        next = ranges;
+        for (std::thread& t: threads)
+            t.join();
+        throw;
+    }
+    run(0);
+    for (std::thread& t: threads)
+        t.join();
+    for (std::exception_ptr& error: errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    // Stitched in order. p is always at the delimiter before an element,
+    // and range i the first one not behind it.
+    consumer.reset();
+    consumer.array_begin();
+    JsonArray& array = std::get<JsonArray>(consumer.parent());
+    ValueParser<JsonConsumer> parser(consumer);
+    const char* p = open;
+    size_t i = 0;
+    while (p != close) {
+        if (i < ranges && p == splits[i] && parsed[i]) {
+            array.insert(array.end(), std::make_move_iterator(arrays[i].begin()), std::make_move_iterator(arrays[i].end()));
+            ++result.ranges;
+            p = range_end(i++);
+            continue;
+        }
+        result.sequential = true;
+        if (!parse_element(parser, p, close)) {
+            result.result = ParseResult::error;
+            return result;
+        }
+        while (i < ranges && splits[i] < p)
+            ++i;
+    }
+    consumer.array_end();
+    return result;
+}
+
+} // namespace libacpp::json
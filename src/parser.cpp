@@ -10,22 +10,16 @@ namespace libacpp::json {
 
 
 
-ParseResult LiteralParser::parse(const char*& p, const char* end) {
-    while(p != end) {
-        //std::cout << "LiteralParser::parse " << literal_ << " " << *p << " p:"  << (void*)p << " end:"  << (void*)end << std::endl;
-        if (*p != literal_[pos_]) {
-            //std::cout << "LiteralParser::parse " << literal_ << " error" << std::endl;
-            return ParseResult::error;
-        }
-        if(pos_ == literal_.size()-1){
-            ++p;
-            //std::cout << "LiteralParser::parse "<< literal_ << " ok" << std::endl;
-            return ParseResult::ok;
-        }
-        ++pos_;
-        ++p;
+std::string to_string(ParseResult r) {
+    switch (r) {
+        case ParseResult::ok:
+            return "ok";
+        case ParseResult::partial:
+            return "partial";
+        case ParseResult::error:
+            return "error";
     }
-    return ParseResult::partial;
+    return "unknown";
 }
 
 } // namespace libacpp::json
@@ -0,0 +1,152 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include <libacpp-json/path.h>
+
+namespace libacpp::json {
+
+namespace {
+
+// "0" or digits without a leading zero, as RFC 6901 wants array indexes
+size_t to_index(std::string_view s) {
+    if (s.empty() || s.size() > 18 || (s[0] == '0' && s.size() > 1))
+        return SIZE_MAX;
+    size_t index = 0;
+    for (char c: s) {
+        if (c < '0' || c > '9')
+            return SIZE_MAX;
+        index = index * 10 + static_cast<size_t>(c - '0');
+    }
+    return index;
+}
+
+} // namespace
+
+JsonPath::Step::Step(std::string k)
+:key(std::move(k)), hash(std::hash<std::string_view>{}(key)), index(to_index(key)) {}
+
+JsonPath JsonPath::pointer(std::string_view pointer) {
+    JsonPath path;
+    if (pointer.empty())
+        return path;
+    if (pointer[0] != '/')
+        throw std::invalid_argument("JsonPath::pointer: must be empty or begin with '/'");
+    size_t i = 1;
+    while (true) {
+        std::string key;
+        for (; i < pointer.size() && pointer[i] != '/'; ++i) {
+            if (pointer[i] != '~') {
+                key.push_back(pointer[i]);
+                continue;
+            }
+            const char e = i + 1 < pointer.size() ? pointer[i + 1] : '\0';
+            if (e != '0' && e != '1')
+                throw std::invalid_argument("JsonPath::pointer: '~' must be followed by '0' or '1'");
+            key.push_back(e == '0' ? '~' : '/');
+            ++i;
+        }
+        path.steps_.emplace_back(std::move(key));
+        if (i == pointer.size())
+            return path;
+        ++i; // the '/'
+    }
+}
+
+JsonPath JsonPath::dotted(std::string_view text) {
+    JsonPath path;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == '[') {
+            const size_t close = text.find(']', i);
+            if (close == std::string_view::npos)
+                throw std::invalid_argument("JsonPath::dotted: unclosed '['");
+            std::string_view index = text.substr(i + 1, close - i - 1);
+            if (to_index(index) == SIZE_MAX)
+                throw std::invalid_argument("JsonPath::dotted: not an array index in '[]'");
+            path.steps_.emplace_back(std::string(index));
+            i = close + 1;
+        } else {
+            const size_t end = std::min(text.find_first_of(".[]", i), text.size());
+            if (end == i)
+                throw std::invalid_argument("JsonPath::dotted: empty key");
+            path.steps_.emplace_back(std::string(text.substr(i, end - i)));
+            i = end;
+        }
+        // a key or an index is followed by the end, '.' and a key, or '['
+        if (i == text.size())
+            break;
+        if (text[i] == '.') {
+            if (++i == text.size())
+                throw std::invalid_argument("JsonPath::dotted: empty key");
+        } else if (text[i] != '[') {
+            throw std::invalid_argument("JsonPath::dotted: unexpected ']'");
+        }
+    }
+    return path;
+}
+
+const JsonValue* JsonPath::member(const JsonObject& object, const Step& step) const {
+    // same shape as the last document: the member is where it was
+    const uint32_t hint = step.hint.load(std::memory_order_relaxed);
+    if (hint < object.size()) {
+        const auto& m = *(object.begin() + hint);
+        if (m.first == std::string_view(step.key))
+            return &m.second;
+    }
+    auto it = object.find(step.key, step.hash);
+    if (it == object.end())
+        return nullptr;
+    step.hint.store(static_cast<uint32_t>(it - object.begin()), std::memory_order_relaxed);
+    return &it->second;
+}
+
+const JsonValue* JsonPath::find(const JsonValue& root) const {
+    const JsonValue* v = &root;
+    for (const Step& step: steps_) {
+        if (auto po = std::get_if<JsonObject>(v)) {
+            v = member(*po, step);
+            if (!v)
+                return nullptr;
+        } else if (auto pa = std::get_if<JsonArray>(v)) {
+            if (step.index >= pa->size())
+                return nullptr;
+            v = &(*pa)[step.index];
+        } else {
+            return nullptr;
+        }
+    }
+    return v;
+}
+
+const JsonValue& JsonPath::at(const JsonValue& root) const {
+    const JsonValue* v = find(root);
+    if (!v)
+        throw std::out_of_range("JsonPath::at: no value at " + str());
+    return *v;
+}
+
+std::string JsonPath::str() const {
+    std::string s;
+    for (const Step& step: steps_) {
+        s.push_back('/');
+        for (char c: step.key) {
+            if (c == '~')
+                s += "~0";
+            else if (c == '/')
+                s += "~1";
+            else
+                s.push_back(c);
+        }
+    }
+    return s;
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,328 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <libacpp-json/reader.h>
+#include <libacpp-json/simd.h>
+#include <libacpp-json/string_ref.h>
+
+namespace libacpp::json {
+
+namespace detail {
+
+void ReaderText::string_raw(std::string_view raw, bool escaped) {
+    if (!escaped) {
+        view_ = raw;
+        return;
+    }
+    unescape(raw, text_);
+    view_ = text_;
+}
+
+} // namespace detail
+
+namespace {
+
+// the bytes that end a number or a literal
+bool scalar_end(char c) {
+    return c == ',' || c == '}' || c == ']' || simd::is_whitespace(c);
+}
+
+} // namespace
+
+JsonReader::JsonReader(size_t max_depth)
+:max_depth_(max_depth), key_parser_(text_), string_parser_(text_), number_parser_(number_) {
+    stack_.reserve(max_depth_);
+}
+
+void JsonReader::reset() {
+    status_ = Status::value;
+    stack_.clear();
+    p_ = end_ = nullptr;
+    finished_ = false;
+}
+
+JsonReader::Token JsonReader::fail() {
+    status_ = Status::failed;
+    return token(Kind::error);
+}
+
+void JsonReader::end_value() {
+    if (stack_.empty())
+        status_ = Status::done;
+    else if (stack_.back())
+        status_ = Status::object_next;
+    else
+        status_ = Status::array_next;
+}
+
+JsonReader::Token JsonReader::open(bool object) {
+    if (stack_.size() == max_depth_)
+        return fail();
+    stack_.push_back(object);
+    ++p_;
+    status_ = object ? Status::object_first : Status::array_first;
+    return token(object ? Kind::object_begin : Kind::array_begin);
+}
+
+JsonReader::Token JsonReader::close() {
+    const bool object = stack_.back();
+    stack_.pop_back();
+    ++p_;
+    end_value();
+    return token(object ? Kind::object_end : Kind::array_end);
+}
+
+JsonReader::Token JsonReader::scalar(ParseResult r, Token t) {
+    if (r == ParseResult::error)
+        return fail();
+    end_value();
+    return t;
+}
+
+JsonReader::Token JsonReader::next() {
+    while (true) {
+        switch (status_) {
+            case Status::key: case Status::string: case Status::number:
+            case Status::null_val: case Status::true_val: case Status::false_val:
+            case Status::skip: case Status::failed:
+                break;
+            default:
+                p_ = simd::skip_whitespace(p_, end_);
+                break;
+        }
+        if (p_ == end_ && status_ != Status::failed) {
+            if (!finished_)
+                return token(Kind::need_input);
+            if (status_ == Status::done)
+                return token(Kind::end);
+            if (status_ == Status::number) {
+                const ParseResult r = number_parser_.finish();
+                return scalar(r, Token{Kind::number, number_.text(), false, number_.value()});
+            }
+            if (status_ == Status::skip && skip_ == Skip::scalar) {
+                end_value();
+                continue;
+            }
+            return fail();
+        }
+
+        ParseResult r;
+        switch (status_) {
+            case Status::value:
+                switch (value_start(*p_)) {
+                    case ValueStart::object:
+                        return open(true);
+                    case ValueStart::array:
+                        return open(false);
+                    case ValueStart::string:
+                        string_parser_.reset();
+                        status_ = Status::string;
+                        break;
+                    case ValueStart::number:
+                        number_parser_.reset();
+                        status_ = Status::number;
+                        break;
+                    case ValueStart::null_val:
+                        null_parser_.reset();
+                        status_ = Status::null_val;
+                        break;
+                    case ValueStart::true_val:
+                        true_parser_.reset();
+                        status_ = Status::true_val;
+                        break;
+                    case ValueStart::false_val:
+                        false_parser_.reset();
+                        status_ = Status::false_val;
+                        break;
+                    default:
+                        return fail();
+                }
+                break;
+            case Status::object_first:
+                if (*p_ == '}')
+                    return close();
+                [[fallthrough]];
+            case Status::object_key:
+                if (*p_ != '"')
+                    return fail();
+                key_parser_.reset();
+                status_ = Status::key;
+                [[fallthrough]];
+            case Status::key:
+                r = key_parser_.parse(p_, end_);
+                if (r == ParseResult::partial)
+                    break;
+                if (r == ParseResult::error)
+                    return fail();
+                status_ = Status::colon;
+                return Token{Kind::key, text_.view()};
+            case Status::colon:
+                if (*p_ != ':')
+                    return fail();
+                ++p_;
+                status_ = Status::value;
+                break;
+            case Status::object_next:
+                if (*p_ == '}')
+                    return close();
+                if (*p_ != ',')
+                    return fail();
+                ++p_;
+                status_ = Status::object_key;
+                break;
+            case Status::array_first:
+                if (*p_ == ']')
+                    return close();
+                status_ = Status::value;
+                break;
+            case Status::array_next:
+                if (*p_ == ']')
+                    return close();
+                if (*p_ != ',')
+                    return fail();
+                ++p_;
+                status_ = Status::value;
+                break;
+            case Status::string:
+                r = string_parser_.parse(p_, end_);
+                if (r != ParseResult::partial)
+                    return scalar(r, Token{Kind::string, text_.view()});
+                break;
+            case Status::number:
+                r = number_parser_.parse(p_, end_);
+                if (r != ParseResult::partial)
+                    return scalar(r, Token{Kind::number, number_.text(), false, number_.value()});
+                break;
+            case Status::null_val:
+                r = null_parser_.parse(p_, end_);
+                if (r != ParseResult::partial)
+                    return scalar(r, token(Kind::null));
+                break;
+            case Status::true_val:
+                r = true_parser_.parse(p_, end_);
+                if (r != ParseResult::partial)
+                    return scalar(r, Token{Kind::boolean, {}, true});
+                break;
+            case Status::false_val:
+                r = false_parser_.parse(p_, end_);
+                if (r != ParseResult::partial)
+                    return scalar(r, Token{Kind::boolean, {}, false});
+                break;
+            case Status::skip:
+                if (skip_bytes()) {
+                    if (skip_pop_)
+                        stack_.pop_back();
+                    end_value();
+                }
+                break;
+            case Status::done:
+                // anything but whitespace after the document
+                return fail();
+            case Status::failed:
+                return token(Kind::error);
+        }
+    }
+}
+
+void JsonReader::skip() {
+    switch (status_) {
+        case Status::colon:
+            skip_ = Skip::colon;
+            skip_pop_ = false;
+            break;
+        case Status::object_first: case Status::object_next:
+        case Status::array_first: case Status::array_next:
+            skip_ = Skip::bytes;
+            skip_depth_ = 1;
+            skip_pop_ = true;
+            break;
+        default:
+            return;
+    }
+    skip_in_string_ = false;
+    skip_escape_ = false;
+    status_ = Status::skip;
+}
+
+bool JsonReader::skip_bytes() {
+    while (p_ != end_) {
+        switch (skip_) {
+            case Skip::colon:
+                p_ = simd::skip_whitespace(p_, end_);
+                if (p_ == end_)
+                    return false;
+                if (*p_ != ':') {
+                    fail();
+                    return false;
+                }
+                ++p_;
+                skip_ = Skip::value;
+                break;
+            case Skip::value:
+                p_ = simd::skip_whitespace(p_, end_);
+                if (p_ == end_)
+                    return false;
+                switch (value_start(*p_)) {
+                    case ValueStart::object: case ValueStart::array:
+                        skip_depth_ = 1;
+                        break;
+                    case ValueStart::string:
+                        skip_depth_ = 0;
+                        skip_in_string_ = true;
+                        break;
+                    case ValueStart::undef:
+                        fail();
+                        return false;
+                    default:
+                        skip_ = Skip::scalar;
+                        continue;
+                }
+                ++p_;
+                skip_ = Skip::bytes;
+                break;
+            case Skip::scalar:
+                while (p_ != end_ && !scalar_end(*p_))
+                    ++p_;
+                return p_ != end_;
+            case Skip::bytes:
+                if (skip_in_string_) {
+                    if (skip_escape_) {
+                        skip_escape_ = false;
+                        ++p_;
+                        break;
+                    }
+                    p_ = simd::find_string_special(p_, end_);
+                    if (p_ == end_)
+                        return false;
+                    const char c = *p_++;
+                    if (c == '"') {
+                        skip_in_string_ = false;
+                        if (skip_depth_ == 0)
+                            return true;
+                    } else if (c == '\\') {
+                        skip_escape_ = true;
+                    }
+                    break;
+                }
+                switch (*p_++) {
+                    case '"':
+                        skip_in_string_ = true;
+                        break;
+                    case '{': case '[':
+                        ++skip_depth_;
+                        break;
+                    case '}': case ']':
+                        if (--skip_depth_ == 0)
+                            return true;
+                        break;
+                }
+                break;
+        }
+    }
+    return false;
+}
+
+} // namespace libacpp::json
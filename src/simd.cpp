@@ -0,0 +1,156 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <atomic>
+
+#include <libacpp-json/simd.h>
+
+#include "simd_target.h"
+
+namespace libacpp::json::simd {
+
+const char* skip_whitespace_scalar(const char* p, const char* end) {
+    while (p != end && is_whitespace(*p))
+        ++p;
+    return p;
+}
+
+#if defined(ACPPJSON_SSE2)
+
+const char* skip_whitespace_sse2(const char* p, const char* end) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i ws = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, cr)));
+        uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(ws)) & 0xffffu;
+        if (mask != 0)
+            return p + std::countr_zero(mask);
+        p += 16;
+    }
+    return skip_whitespace_scalar(p, end);
+}
+
+#else
+
+const char* skip_whitespace_sse2(const char* p, const char* end) {
+    return skip_whitespace_scalar(p, end);
+}
+
+#endif
+
+#if defined(ACPPJSON_X86)
+
+ACPPJSON_TARGET_AVX2
+const char* skip_whitespace_avx2(const char* p, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i ws = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, nl), _mm256_cmpeq_epi8(v, cr)));
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+        if (mask != 0)
+            return p + std::countr_zero(mask);
+        p += 32;
+    }
+    return skip_whitespace_sse2(p, end);
+}
+
+bool has_sse2() {
+#if defined(ACPPJSON_SSE2)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool has_avx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+const char* skip_whitespace_avx2(const char* p, const char* end) {
+    return skip_whitespace_sse2(p, end);
+}
+
+bool has_sse2() { return false; }
+bool has_avx2() { return false; }
+
+#endif
+
+namespace {
+
+struct Kernel {
+    skip_whitespace_fn fn;
+    const char* name;
+};
+
+Kernel select_kernel() {
+    if (has_avx2())
+        return {skip_whitespace_avx2, "avx2"};
+#if defined(ACPPJSON_SSE2)
+    return {skip_whitespace_sse2, "sse2"};
+#else
+    return {skip_whitespace_scalar, "scalar"};
+#endif
+}
+
+const Kernel& kernel() {
+    static const Kernel k = select_kernel();
+    return k;
+}
+
+const char* skip_whitespace_resolve(const char* p, const char* end);
+
+// starts at the resolver, which swaps in the selected kernel on first use
+std::atomic<skip_whitespace_fn> skip_whitespace_impl{skip_whitespace_resolve};
+
+const char* skip_whitespace_resolve(const char* p, const char* end) {
+    skip_whitespace_fn fn = kernel().fn;
+    skip_whitespace_impl.store(fn, std::memory_order_relaxed);
+    return fn(p, end);
+}
+
+} // namespace
+
+skip_whitespace_fn skip_whitespace_kernel() {
+    return skip_whitespace_impl.load(std::memory_order_relaxed);
+}
+
+const char* skip_whitespace_kernel_name() {
+    return kernel().name;
+}
+
+} // namespace libacpp::json::simd
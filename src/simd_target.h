@@ -0,0 +1,24 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+// The runtime-dispatched kernels of simd.cpp and structural.cpp, for x86
+// only: ACPPJSON_TARGET_AVX2 compiles a function for AVX2 whatever the
+// flags of the build, and the caller checks simd::has_avx2() first.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define ACPPJSON_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define ACPPJSON_TARGET_AVX2
+        #define ACPPJSON_FLATTEN
+    #else
+        #include <immintrin.h>
+        #define ACPPJSON_TARGET_AVX2 __attribute__((target("avx2")))
+        // inlines the callees into a kernel, under its target
+        #define ACPPJSON_FLATTEN __attribute__((flatten))
+    #endif
+#endif
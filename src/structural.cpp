@@ -0,0 +1,286 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#include <libacpp-json/simd.h>
+#include <libacpp-json/structural.h>
+
+#include "simd_target.h"
+
+namespace libacpp::json {
+
+namespace simd {
+
+namespace {
+
+bool is_operator(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+} // namespace
+
+// Byte at a time reference: the vector kernels must match it exactly.
+uint32_t* find_structurals_scalar(const char* begin, const char* end, uint32_t* out) {
+    bool escaped = false;
+    bool in_string = false;
+    bool prev_scalar = false;
+    for (const char* p = begin; p != end; ++p) {
+        char c = *p;
+        bool quote = c == '"' && !escaped;
+        escaped = c == '\\' && !escaped;
+        bool op = is_operator(c);
+        bool ws = is_whitespace(c);
+        if (in_string) {
+            in_string = !quote;
+        } else if (quote) {
+            *out++ = static_cast<uint32_t>(p - begin);
+            in_string = true;
+        } else if (op || (!ws && !prev_scalar)) {
+            *out++ = static_cast<uint32_t>(p - begin);
+        }
+        prev_scalar = !op && !ws && !quote;
+    }
+    return in_string ? nullptr : out;
+}
+
+namespace {
+
+// One bit per byte of a 64 byte block.
+struct BlockMasks {
+    uint64_t backslash;
+    uint64_t quote;
+    uint64_t whitespace;
+    uint64_t op;
+};
+
+// Bits of the bytes preceded by an odd number of backslashes, carrying the
+// state of a backslash run that reaches the end of the block.
+inline uint64_t escaped_bits(uint64_t backslash, uint64_t& prev_odd) {
+    const uint64_t even_bits = 0x5555555555555555ull;
+    const uint64_t odd_bits = ~even_bits;
+    uint64_t start_edges = backslash & ~(backslash << 1);
+    uint64_t even_start_mask = even_bits ^ prev_odd;
+    uint64_t even_starts = start_edges & even_start_mask;
+    uint64_t odd_starts = start_edges & ~even_start_mask;
+    uint64_t even_carries = backslash + even_starts;
+    uint64_t odd_carries = backslash + odd_starts;
+    bool ends_odd = odd_carries < backslash;
+    odd_carries |= prev_odd;
+    prev_odd = ends_odd ? 1 : 0;
+    uint64_t even_carry_ends = even_carries & ~backslash;
+    uint64_t odd_carry_ends = odd_carries & ~backslash;
+    return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+}
+
+// Bit i set when an odd number of bits in [0, i] are set.
+inline uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+template <typename Classify>
+inline uint32_t* scan(const char* begin, const char* end, uint32_t* out, Classify classify) {
+    const size_t size = static_cast<size_t>(end - begin);
+    uint64_t prev_odd = 0;
+    uint64_t prev_in_string = 0;
+    uint64_t prev_scalar = 0;
+    char padded[64];
+    for (size_t offset = 0; offset < size; offset += 64) {
+        const char* block = begin + offset;
+        if (size - offset < 64) {
+            std::memset(padded, ' ', sizeof(padded));
+            std::memcpy(padded, block, size - offset);
+            block = padded;
+        }
+        BlockMasks m = classify(block);
+
+        uint64_t quote = m.quote & ~escaped_bits(m.backslash, prev_odd);
+        uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+        // string content and closing quotes; opening quotes are not included
+        uint64_t string_tail = in_string ^ quote;
+
+        uint64_t scalar = ~(m.op | m.whitespace | quote);
+        uint64_t follows_scalar = (scalar << 1) | prev_scalar;
+        prev_scalar = scalar >> 63;
+        uint64_t starts = (m.op | quote | (scalar & ~follows_scalar)) & ~string_tail;
+
+        // unconditional writes in groups of 8: most blocks hold few
+        // positions, so the loop exit stays predictable
+        const int count = std::popcount(starts);
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint32_t>(offset + std::countr_zero(starts));
+            starts &= starts - 1;
+        }
+        for (int i = 8; i < count; i += 8) {
+            for (int j = i; j < i + 8; ++j) {
+                out[j] = static_cast<uint32_t>(offset + std::countr_zero(starts));
+                starts &= starts - 1;
+            }
+        }
+        out += count;
+    }
+    return prev_in_string ? nullptr : out;
+}
+
+} // namespace
+
+#if defined(ACPPJSON_SSE2)
+
+namespace {
+
+inline uint64_t movemask64_sse2(__m128i a, __m128i b, __m128i c, __m128i d) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(a)))
+        | (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(b))) << 16)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c))) << 32)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(d))) << 48);
+}
+
+struct ClassifySse2 {
+    BlockMasks operator()(const char* block) const {
+        __m128i backslash[4], quote[4], ws[4], op[4];
+        for (int i = 0; i < 4; ++i) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            backslash[i] = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+            quote[i] = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+            ws[i] = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            op[i] = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        }
+        return {movemask64_sse2(backslash[0], backslash[1], backslash[2], backslash[3]),
+            movemask64_sse2(quote[0], quote[1], quote[2], quote[3]),
+            movemask64_sse2(ws[0], ws[1], ws[2], ws[3]),
+            movemask64_sse2(op[0], op[1], op[2], op[3])};
+    }
+};
+
+} // namespace
+
+uint32_t* find_structurals_sse2(const char* begin, const char* end, uint32_t* out) {
+    return scan(begin, end, out, ClassifySse2{});
+}
+
+#else
+
+uint32_t* find_structurals_sse2(const char* begin, const char* end, uint32_t* out) {
+    return find_structurals_scalar(begin, end, out);
+}
+
+#endif
+
+#if defined(ACPPJSON_X86)
+
+namespace {
+
+ACPPJSON_TARGET_AVX2
+inline uint64_t movemask64_avx2(__m256i lo, __m256i hi) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(lo)))
+        | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi))) << 32);
+}
+
+struct ClassifyAvx2 {
+    ACPPJSON_TARGET_AVX2
+    BlockMasks operator()(const char* block) const {
+        __m256i backslash[2], quote[2], ws[2], op[2];
+        for (int i = 0; i < 2; ++i) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+            __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+            backslash[i] = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+            quote[i] = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+            ws[i] = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+            op[i] = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+        }
+        return {movemask64_avx2(backslash[0], backslash[1]), movemask64_avx2(quote[0], quote[1]),
+            movemask64_avx2(ws[0], ws[1]), movemask64_avx2(op[0], op[1])};
+    }
+};
+
+} // namespace
+
+ACPPJSON_TARGET_AVX2 ACPPJSON_FLATTEN
+uint32_t* find_structurals_avx2(const char* begin, const char* end, uint32_t* out) {
+    return scan(begin, end, out, ClassifyAvx2{});
+}
+
+#else
+
+uint32_t* find_structurals_avx2(const char* begin, const char* end, uint32_t* out) {
+    return find_structurals_sse2(begin, end, out);
+}
+
+#endif
+
+namespace {
+
+struct Kernel {
+    find_structurals_fn fn;
+    const char* name;
+};
+
+Kernel select_kernel() {
+    if (has_avx2())
+        return {find_structurals_avx2, "avx2"};
+#if defined(ACPPJSON_SSE2)
+    return {find_structurals_sse2, "sse2"};
+#else
+    return {find_structurals_scalar, "scalar"};
+#endif
+}
+
+const Kernel& kernel() {
+    static const Kernel k = select_kernel();
+    return k;
+}
+
+} // namespace
+
+find_structurals_fn find_structurals_kernel() {
+    return kernel().fn;
+}
+
+const char* find_structurals_kernel_name() {
+    return kernel().name;
+}
+
+} // namespace simd
+
+
+StructuralIndex::Result StructuralIndex::build(const char* begin, const char* end) {
+    const size_t size = static_cast<size_t>(end - begin);
+    if (size >= std::numeric_limits<uint32_t>::max())
+        return Result::too_large;
+    if (capacity_ < size + simd::structurals_padding) {
+        positions_.reset(new uint32_t[size + simd::structurals_padding]);
+        capacity_ = size + simd::structurals_padding;
+    }
+    uint32_t* last = simd::find_structurals_kernel()(begin, end, positions_.get());
+    if (last == nullptr) {
+        size_ = 0;
+        return Result::open_string;
+    }
+    *last++ = static_cast<uint32_t>(size);
+    size_ = static_cast<size_t>(last - positions_.get());
+    return Result::ok;
+}
+
+} // namespace libacpp::json
@@ -0,0 +1,282 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <libacpp-json/tape.h>
+
+namespace libacpp::json {
+
+// short strings are read in place, from the bytes of their word
+static_assert(std::endian::native == std::endian::little, "the tape assumes a little endian target");
+
+size_t TapeRef::end_index() const {
+    switch (type()) {
+        case TapeType::int64:
+        case TapeType::uint64:
+        case TapeType::double_val:
+            return index_ + 2;
+        case TapeType::object_begin:
+        case TapeType::array_begin:
+            return static_cast<size_t>(Tape::payload(word()) & 0xffffffffu) + 1;
+        default:
+            return index_ + 1;
+    }
+}
+
+double TapeRef::get_double() const {
+    switch (type()) {
+        case TapeType::int64:
+            return static_cast<double>(get_int64());
+        case TapeType::uint64:
+            return static_cast<double>(get_uint64());
+        default:
+            return std::bit_cast<double>(next_word());
+    }
+}
+
+std::string_view TapeRef::get_string() const {
+    const uint64_t& w = tape_->words()[index_];
+    if (type() == TapeType::short_string) {
+        const char* bytes = reinterpret_cast<const char*>(&w);
+        return {bytes + 1, static_cast<size_t>(w & 0xff)};
+    }
+    const char* s = tape_->strings().data() + Tape::payload(w);
+    uint32_t length;
+    std::memcpy(&length, s, sizeof(length));
+    return {s + sizeof(length), length};
+}
+
+size_t TapeRef::size() const {
+    size_t count = static_cast<size_t>(Tape::payload(word()) >> 32);
+    if (count < Tape::max_count)
+        return count;
+    count = 0;
+    if (is_object()) {
+        for ([[maybe_unused]] auto member: members())
+            ++count;
+    } else {
+        for ([[maybe_unused]] auto element: elements())
+            ++count;
+    }
+    return count;
+}
+
+TapeRange<TapeArrayIterator> TapeRef::elements() const {
+    return {TapeArrayIterator(*tape_, index_ + 1), TapeArrayIterator(*tape_, end_index() - 1)};
+}
+
+TapeRange<TapeObjectIterator> TapeRef::members() const {
+    return {TapeObjectIterator(*tape_, index_ + 1), TapeObjectIterator(*tape_, end_index() - 1)};
+}
+
+std::optional<TapeRef> TapeRef::find(std::string_view key) const {
+    if (!is_object())
+        return std::nullopt;
+    // the last member with the key, as JsonConsumer keeps it
+    std::optional<TapeRef> found;
+    for (auto member: members()) {
+        if (member.key == key)
+            found = member.value;
+    }
+    return found;
+}
+
+std::optional<TapeRef> TapeRef::at(size_t i) const {
+    if (!is_array())
+        return std::nullopt;
+    for (auto element: elements()) {
+        if (i-- == 0)
+            return element;
+    }
+    return std::nullopt;
+}
+
+
+void TapeConsumer::reset() {
+    tape_.clear();
+    open_.clear();
+    failed_ = false;
+}
+
+void TapeConsumer::value_added() {
+    if (!open_.empty() && open_.back().count < Tape::max_count)
+        ++open_.back().count;
+}
+
+void TapeConsumer::open(TapeType type) {
+    value_added();
+    open_.push_back({tape_.words_.size(), 0});
+    push(type, 0); // patched by close()
+}
+
+void TapeConsumer::close(TapeType type) {
+    const Open o = open_.back();
+    open_.pop_back();
+    const size_t end = tape_.words_.size();
+    if (end > Tape::max_index)
+        failed_ = true;
+    uint64_t& begin = tape_.words_[o.begin];
+    begin = Tape::word(Tape::type(begin), (static_cast<uint64_t>(o.count) << 32) | end);
+    push(type, o.begin);
+}
+
+void TapeConsumer::begin_string() {
+    // room for the length, written by end_string()
+    string_start_ = tape_.strings_.size();
+    tape_.strings_.append(sizeof(uint32_t), '\0');
+}
+
+void TapeConsumer::end_string(bool is_key) {
+    std::string& strings = tape_.strings_;
+    const size_t content = string_start_ + sizeof(uint32_t);
+    const size_t length = strings.size() - content;
+    if (length <= Tape::short_string_max) {
+        uint64_t payload = length;
+        std::memcpy(reinterpret_cast<char*>(&payload) + 1, strings.data() + content, length);
+        strings.resize(string_start_);
+        push(TapeType::short_string, payload);
+    } else {
+        if (length > Tape::max_string_length)
+            failed_ = true;
+        const uint32_t length32 = static_cast<uint32_t>(length);
+        std::memcpy(strings.data() + string_start_, &length32, sizeof(length32));
+        push(TapeType::string, string_start_);
+    }
+    if (!is_key)
+        value_added();
+}
+
+void TapeConsumer::string_raw(std::string_view raw, bool escaped) {
+    if (escaped) {
+        StringParser<TapeConsumer, false>(*this).parse_content(raw);
+        return;
+    }
+    begin_string();
+    tape_.strings_.append(raw);
+    end_string(false);
+}
+
+void TapeConsumer::key_raw(std::string_view raw, bool escaped) {
+    if (escaped) {
+        StringParser<TapeConsumer, true>(*this).parse_content(raw);
+        return;
+    }
+    begin_string();
+    tape_.strings_.append(raw);
+    end_string(true);
+}
+
+void TapeConsumer::number_value(int64_t v) {
+    value_added();
+    push(TapeType::int64, 0);
+    tape_.words_.push_back(std::bit_cast<uint64_t>(v));
+}
+
+void TapeConsumer::number_value(uint64_t v) {
+    value_added();
+    push(TapeType::uint64, 0);
+    tape_.words_.push_back(v);
+}
+
+void TapeConsumer::number_value(double v) {
+    value_added();
+    push(TapeType::double_val, 0);
+    tape_.words_.push_back(std::bit_cast<uint64_t>(v));
+}
+
+void TapeConsumer::set_bool(bool v) {
+    value_added();
+    push(v ? TapeType::true_val : TapeType::false_val, 0);
+}
+
+void TapeConsumer::set_null() {
+    value_added();
+    push(TapeType::null_val, 0);
+}
+
+
+JsonValue to_json_value(const TapeRef& value, std::pmr::memory_resource* resource) {
+    switch (value.type()) {
+        case TapeType::null_val:
+            return JsonValue(nullptr);
+        case TapeType::true_val:
+        case TapeType::false_val:
+            return JsonValue(value.get_bool());
+        case TapeType::int64:
+            return JsonValue(value.get_int64());
+        case TapeType::uint64:
+            return JsonValue(value.get_uint64());
+        case TapeType::double_val:
+            return JsonValue(value.get_double());
+        case TapeType::string:
+        case TapeType::short_string:
+            return JsonValue(JsonString(value.get_string(), resource));
+        case TapeType::object_begin: {
+            JsonObject object(resource);
+            object.reserve(value.size());
+            // a duplicate key keeps its last value
+            for (auto member: value.members())
+                object[member.key] = to_json_value(member.value, resource);
+            return JsonValue(std::move(object));
+        }
+        case TapeType::array_begin: {
+            JsonArray array(resource);
+            array.reserve(value.size());
+            for (auto element: value.elements())
+                array.push_back(to_json_value(element, resource));
+            return JsonValue(std::move(array));
+        }
+        default:
+            return JsonValue();
+    }
+}
+
+namespace {
+
+void add_to_tape(const JsonValue& value, TapeConsumer& consumer) {
+    std::visit([&](auto&& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            consumer.set_bool(v);
+        } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, double>) {
+            consumer.number_value(v);
+        } else if constexpr (std::is_same_v<T, JsonRawNumber>) {
+            if (auto i = v.as_int64())
+                consumer.number_value(*i);
+            else if (auto u = v.as_uint64())
+                consumer.number_value(*u);
+            else
+                consumer.number_value(v.as_double());
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            consumer.set_null();
+        } else if constexpr (std::is_same_v<T, JsonString>) {
+            consumer.string_raw(v, false);
+        } else if constexpr (std::is_same_v<T, JsonStringRef>) {
+            consumer.string_raw(v.view(), false);
+        } else if constexpr (std::is_same_v<T, JsonObject>) {
+            consumer.object_begin();
+            for (const auto& [key, member]: v) {
+                consumer.key_raw(key.view(), false);
+                add_to_tape(member, consumer);
+            }
+            consumer.object_end();
+        } else if constexpr (std::is_same_v<T, JsonArray>) {
+            consumer.array_begin();
+            for (const auto& element: v)
+                add_to_tape(element, consumer);
+            consumer.array_end();
+        }
+    }, static_cast<const JsonValue::variant_type&>(value));
+}
+
+} // namespace
+
+void to_tape(const JsonValue& value, Tape& tape) {
+    TapeConsumer consumer(tape);
+    consumer.reset();
+    add_to_tape(value, consumer);
+}
+
+} // namespace libacpp::json
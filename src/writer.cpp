@@ -0,0 +1,181 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h>
+    #define ACPPJSON_POSIX_WRITE 1
+#endif
+
+#include <libacpp-json/simd.h>
+#include <libacpp-json/writer.h>
+
+namespace libacpp::json {
+
+void WriteBuffer::make_room(size_t n) {
+    size_t capacity;
+    if (fd_ >= 0) {
+        // the buffer holds flush_size bytes: when it is full, write it out
+        flush();
+        if (capacity_ >= n)
+            return;
+        capacity = std::max(flush_size_, n);
+    } else {
+        capacity = std::max({capacity_ * 2, size_ + n, size_t{256}});
+    }
+    std::unique_ptr<char[]> data(new char[capacity]);
+    if (size_ != 0)
+        std::memcpy(data.get(), data_.get(), size_);
+    data_ = std::move(data);
+    capacity_ = capacity;
+}
+
+bool WriteBuffer::flush() {
+    if (fd_ < 0 || size_ == 0)
+        return !failed_;
+#if defined(ACPPJSON_POSIX_WRITE)
+    const char* p = data_.get();
+    size_t left = size_;
+    while (left != 0 && !failed_) {
+        ssize_t n = ::write(fd_, p, left);
+        if (n < 0)
+            failed_ = true;
+        else {
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+    }
+#else
+    failed_ = true;
+#endif
+    size_ = 0;
+    return !failed_;
+}
+
+
+namespace write {
+
+namespace {
+
+// the escape of each byte below 0x20, "" for the \u00XX ones
+constexpr std::string_view short_escapes[0x20] = {
+    "", "", "", "", "", "", "", "", "\\b", "\\t", "\\n", "", "\\f", "\\r", "", "",
+    "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "",
+};
+
+} // namespace
+
+void string(WriteBuffer& out, std::string_view s) {
+    out.push_back('"');
+    string_content(out, s);
+    out.push_back('"');
+}
+
+void string_content(WriteBuffer& out, std::string_view s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (true) {
+        const char* q = simd::find_string_special(p, end);
+        out.append(std::string_view(p, q - p));
+        if (q == end)
+            break;
+        const unsigned char c = static_cast<unsigned char>(*q);
+        if (c == '"') {
+            out.append("\\\"");
+        } else if (c == '\\') {
+            out.append("\\\\");
+        } else if (!short_escapes[c].empty()) {
+            out.append(short_escapes[c]);
+        } else {
+            static constexpr char hex[] = "0123456789abcdef";
+            char* w = out.reserve(6);
+            std::memcpy(w, "\\u00", 4);
+            w[4] = hex[c >> 4];
+            w[5] = hex[c & 0xf];
+            out.commit(6);
+        }
+        p = q + 1;
+    }
+}
+
+void number(WriteBuffer& out, int64_t v) {
+    char* w = out.reserve(20);
+    out.commit(std::to_chars(w, w + 20, v).ptr - w);
+}
+
+void number(WriteBuffer& out, uint64_t v) {
+    char* w = out.reserve(20);
+    out.commit(std::to_chars(w, w + 20, v).ptr - w);
+}
+
+void number(WriteBuffer& out, double v) {
+    if (!std::isfinite(v)) {
+        out.append("null");
+        return;
+    }
+    // the shortest round trip form is at most 24 bytes ("-2.2250738585072014e-308")
+    char* w = out.reserve(32);
+    char* end = std::to_chars(w, w + 32, v).ptr;
+    if (std::find_if(w, end, [](char c) { return c == '.' || c == 'e'; }) == end) {
+        std::memcpy(end, ".0", 2);
+        end += 2;
+    }
+    out.commit(end - w);
+}
+
+} // namespace write
+
+
+namespace {
+
+constexpr size_t pretty_indent = 2;
+
+} // namespace
+
+void JsonWriter::new_line(size_t depth) {
+    char* w = out_.reserve(depth * pretty_indent + 1);
+    w[0] = '\n';
+    std::memset(w + 1, ' ', depth * pretty_indent);
+    out_.commit(depth * pretty_indent + 1);
+}
+
+void JsonWriter::separator() {
+    if (!first_)
+        out_.push_back(',');
+    first_ = false;
+    if (format_ == JsonFormat::pretty && !open_.empty())
+        new_line(open_.size());
+}
+
+void JsonWriter::key_end() {
+    out_.push_back('"');
+    colon();
+}
+
+void JsonWriter::colon() {
+    out_.append(format_ == JsonFormat::pretty ? ": " : ":");
+    after_key_ = true;
+}
+
+void JsonWriter::open(char c) {
+    value_begin();
+    out_.push_back(c);
+    open_.push_back(c);
+    first_ = true;
+}
+
+void JsonWriter::close(char c) {
+    open_.pop_back();
+    if (format_ == JsonFormat::pretty && !first_)
+        new_line(open_.size());
+    out_.push_back(c);
+    first_ = false;
+}
+
+} // namespace libacpp::json
@@ -43,7 +43,7 @@ TEST(ConsumerTests, test1) {
     JsonValue o2{JsonObject()};
     std::get<JsonObject>(o2)["hola"] = JsonValue("hola");
     auto v = std::get<JsonObject>(o2)["hola"];
-    std::cout << "get: " << std::get<std::string>(v) << std::endl;
+    std::cout << "get: " << std::get<JsonString>(v) << std::endl;
     std::get<JsonObject>(o2)["hola"] = JsonValue{"mundo"};
     std::get<JsonObject>(o2)["hola2"] = JsonValue{"mundo2"};
 
@@ -52,7 +52,7 @@ TEST(ConsumerTests, test1) {
 
 
     v = std::get<JsonObject>(o2)["hola"];    
-    std::cout << "get: " << std::get<std::string>(v) << std::endl;
+    std::cout << "get: " << std::get<JsonString>(v) << std::endl;
     std::stringstream ss;
     to_string(o2, ss);
     std::cout << "get: " << ss.str() << std::endl;
@@ -62,6 +62,34 @@ TEST(ConsumerTests, test1) {
 
 using namespace libacpp::json;
 
+namespace {
+
+// the document as JsonConsumer builds it, as text
+std::string dom_text(const std::string& input) {
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    EXPECT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << input;
+    std::stringstream ss;
+    to_string(consumer.root(), ss);
+    return ss.str();
+}
+
+// Parses input into consumer, in one chunk or one byte at a time.
+ParseResult parse_dom(JsonConsumer& consumer, const std::string& input, bool chunked) {
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    const char* end = p + input.size();
+    if (!chunked)
+        return vp.parse(p, end);
+    ParseResult r = ParseResult::partial;
+    while (p != end && r == ParseResult::partial)
+        r = vp.parse(p, p + 1);
+    return r;
+}
+
+} // namespace
+
 TEST(ConsumerTests, test2) {
     struct Test {
         std::string input;
@@ -83,7 +111,10 @@ TEST(ConsumerTests, test2) {
         {R"({"k1":"v1"})", ParseResult::ok, R"({"k1":"v1"})"},
         {R"({"k1":"v1", "k2": "v2"})", ParseResult::ok, R"({"k1":"v1","k2":"v2"})"}, 
         {R"({"k1":"v1", "o1": {"k2": "v2"}})", ParseResult::ok, R"({"k1":"v1","o1":{"k2":"v2"}})"}, 
-        {R"({"k1":"v1", "a1": ["v2", "v3"]})", ParseResult::ok, R"({"a1":["v2","v3"],"k1":"v1"})"} 
+        {R"({"k1":"v1", "a1": ["v2", "v3"]})", ParseResult::ok, R"({"k1":"v1","a1":["v2","v3"]})"}, 
+        {R"({"o1":{"k2":"v2"},"k1":"v1"})", ParseResult::ok, R"({"o1":{"k2":"v2"},"k1":"v1"})"},
+        {R"({"k1":"v1","k1":"v2"})", ParseResult::ok, R"({"k1":"v2"})"},
+        {R"([{"k1":"v1"},[],{}])", ParseResult::ok, R"([{"k1":"v1"},[],{}])"}
 
     };
     bool sync_test{true};
@@ -138,3 +169,288 @@ TEST(ConsumerTests, test2) {
     // }
 
 }
+
+TEST(ConsumerTests, ViewStrings) {
+    const std::string input = R"({"k1":["plain","tab\tand \"quote\"",1,""]})";
+    for (auto strings: {JsonConsumer::Strings::copy, JsonConsumer::Strings::view}) {
+        JsonConsumer consumer(strings);
+        ValueParser<JsonConsumer> vp(consumer);
+        const char* p = input.data();
+        ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+        std::stringstream ss;
+        to_string(consumer.root(), ss);
+        // escapes are written back
+        EXPECT_EQ(ss.str(), input);
+
+        auto& array = std::get<JsonArray>(std::get<JsonObject>(consumer.root()).at("k1"));
+        if (strings == JsonConsumer::Strings::copy) {
+            EXPECT_EQ(std::get<JsonString>(array[0]), "plain");
+            EXPECT_EQ(std::get<JsonString>(array[1]), "tab\tand \"quote\"");
+            continue;
+        }
+        // views into the input, decoded on first access only
+        auto& plain = std::get<JsonStringRef>(array[0]);
+        EXPECT_FALSE(plain.escaped());
+        EXPECT_EQ(plain.view().data(), input.data() + input.find("plain"));
+        auto& escaped = std::get<JsonStringRef>(array[1]);
+        EXPECT_TRUE(escaped.escaped());
+        EXPECT_EQ(escaped.raw(), R"(tab\tand \"quote\")");
+        EXPECT_EQ(escaped.raw().data(), input.data() + input.find("tab"));
+        std::string_view decoded = escaped.view();
+        EXPECT_EQ(decoded, "tab\tand \"quote\"");
+        EXPECT_EQ(escaped.view().data(), decoded.data());
+        EXPECT_EQ(std::get<JsonStringRef>(array[3]).view(), "");
+    }
+
+    // strings cut by the end of a chunk cannot be views: they are copied
+    JsonConsumer consumer(JsonConsumer::Strings::view);
+    ValueParser<JsonConsumer> vp(consumer);
+    const std::string chunked = R"(["abc","def"])";
+    const char* p = chunked.data();
+    const char* end = p + chunked.size();
+    ASSERT_EQ(vp.parse(p, p + 4), ParseResult::partial);
+    ASSERT_EQ(vp.parse(p, end), ParseResult::ok);
+    auto& array = std::get<JsonArray>(consumer.root());
+    EXPECT_EQ(std::get<JsonString>(array[0]), "abc");
+    EXPECT_EQ(std::get<JsonStringRef>(array[1]).view(), "def");
+}
+
+// Counts what reaches it and forwards to new/delete.
+class CountingResource: public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t bytes = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        this->bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(ConsumerTests, Arena) {
+    const std::string input = R"({"a long key that does not fit in place":["a string value long enough to be allocated",)"
+        R"(12345,-1.5,true,null,{"nested":["x","escaped \"string\" that is long enough"]}],"k":{}})";
+    std::string expected;
+    {
+        JsonConsumer consumer;
+        ValueParser<JsonConsumer> vp(consumer);
+        const char* p = input.data();
+        ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+        std::stringstream ss;
+        to_string(consumer.root(), ss);
+        expected = ss.str();
+    }
+
+    JsonArena arena(256);
+    CountingResource counting;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counting);
+    for (auto strings: {JsonConsumer::Strings::copy, JsonConsumer::Strings::view}) {
+        JsonConsumer consumer(arena, strings);
+        for (int message = 0; message < 3; ++message) {
+            ValueParser<JsonConsumer> vp(consumer);
+            const char* p = input.data();
+            ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+            std::stringstream ss;
+            to_string(consumer.root(), ss);
+            EXPECT_EQ(ss.str(), expected);
+            EXPECT_GT(arena.used(), 0u);
+            // the first document outgrows the 256 byte block; after a release
+            // the block fits it
+            if (message > 0) {
+                EXPECT_LE(arena.used(), arena.block_size());
+            }
+            consumer.reset();
+            // only the root of the next document
+            EXPECT_EQ(arena.used(), sizeof(JsonValue));
+        }
+    }
+    std::pmr::set_default_resource(previous);
+    // nothing of the documents came from the default resource
+    EXPECT_EQ(counting.allocations, 0u);
+
+    // without an arena reset() starts a new document too
+    JsonConsumer consumer;
+    for (const std::string doc: {"[1,2]", R"({"a":"b"})"}) {
+        consumer.reset();
+        ValueParser<JsonConsumer> vp(consumer);
+        const char* p = doc.data();
+        ASSERT_EQ(vp.parse(p, p + doc.size()), ParseResult::ok);
+        std::stringstream ss;
+        to_string(consumer.root(), ss);
+        EXPECT_EQ(ss.str(), doc);
+    }
+}
+
+TEST(ConsumerTests, Moves) {
+    const std::string key1 = "a key long enough to be allocated";
+    const std::string value1 = "a string value long enough to be allocated";
+    const std::string key2 = R"(an \"escaped\" key long enough to be allocated)";
+    const std::string decoded_key2 = R"(an "escaped" key long enough to be allocated)";
+    const std::string value2 = "another string value that is allocated";
+    const std::string input = "{\"" + key1 + "\":\"" + value1 + "\",\"" + key2 + "\":\"" + value2 + "\"}";
+
+    for (bool chunked: {false, true}) {
+        CountingResource counting;
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counting);
+        {
+            JsonConsumer consumer;
+            ASSERT_EQ(parse_dom(consumer, input, chunked), ParseResult::ok);
+            auto& object = std::get<JsonObject>(consumer.root());
+            EXPECT_EQ(std::string_view(std::get<JsonString>(object.at(key1))), value1);
+            EXPECT_EQ(std::string_view(std::get<JsonString>(object.at(decoded_key2))), value2);
+
+            // one allocation per string, moved into the tree, plus the two
+            // of the members vector (1 and 2 members): no temporaries. Whole
+            // strings reserve their raw size before decoding; strings cut by
+            // a chunk are copied out of the reused buffer at their exact size.
+            EXPECT_EQ(counting.allocations, 6u) << "chunked: " << chunked;
+            const size_t escaped_key = chunked ? decoded_key2.size() : key2.size();
+            EXPECT_EQ(counting.bytes, key1.size() + 1 + value1.size() + 1 + escaped_key + 1 + value2.size() + 1
+                + 3 * sizeof(JsonObject::value_type)) << "chunked: " << chunked;
+        }
+        std::pmr::set_default_resource(previous);
+    }
+}
+
+TEST(ConsumerTests, Object) {
+    // members stay in document order on both sides of the hash threshold
+    for (size_t n: {size_t{3}, JsonObject::hash_threshold + 1, size_t{200}}) {
+        std::string input = "{";
+        for (size_t i = n; i-- > 0;)
+            input += "\"k" + std::to_string(i) + "\":" + std::to_string(i) + (i ? "," : "}");
+        JsonConsumer consumer;
+        ValueParser<JsonConsumer> vp(consumer);
+        const char* p = input.data();
+        ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+        std::stringstream ss;
+        to_string(consumer.root(), ss);
+        EXPECT_EQ(ss.str(), input);
+
+        auto& object = std::get<JsonObject>(consumer.root());
+        ASSERT_EQ(object.size(), n);
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_EQ(std::get<int64_t>(object.at("k" + std::to_string(i))), static_cast<int64_t>(i));
+        EXPECT_EQ(object.find("missing"), object.end());
+        EXPECT_FALSE(object.contains("k"));
+        EXPECT_THROW(object.at("missing"), std::out_of_range);
+        // an existing key is found, not added
+        EXPECT_FALSE(object.try_emplace("k0", 7).second);
+        object["new"] = JsonValue(true);
+        EXPECT_EQ(object.size(), n + 1);
+        EXPECT_EQ((object.end() - 1)->first, "new");
+        EXPECT_TRUE(object.contains("new"));
+    }
+
+    // keys and members come from the object's resource
+    JsonArena arena;
+    JsonObject object(&arena);
+    object.try_emplace("a key that does not fit in place", 1);
+    EXPECT_EQ(object.begin()->first.get_allocator().resource(), &arena);
+}
+
+TEST(ConsumerTests, KeyTable) {
+    const std::string input = R"({"a key long enough to be allocated":1,"esc\"aped key long enough to be allocated":)"
+        R"([{"a key long enough to be allocated":2}],"k0":0,"k1":1,"k2":2,"k3":3,"k4":4,"k5":5,"k6":6,"k7":7,)"
+        R"("k8":8,"k9":9,"k10":10,"k11":11,"k12":12,"k13":13,"k14":14,"k15":15,"k16":16})";
+    const std::string expected = dom_text(input);
+    const std::string long_key = "a key long enough to be allocated";
+    const std::string escaped_key = R"(esc"aped key long enough to be allocated)";
+
+    KeyTable table;
+    JsonConsumer consumer;
+    consumer.set_key_table(&table);
+    const KeyTable::Symbol* first = nullptr;
+    for (bool chunked: {false, true, false}) {
+        consumer.reset();
+        ASSERT_EQ(parse_dom(consumer, input, chunked), ParseResult::ok);
+        std::stringstream ss;
+        to_string(consumer.root(), ss);
+        EXPECT_EQ(ss.str(), expected);
+        EXPECT_EQ(table.size(), 19u);
+
+        // every document points at the same symbols
+        auto& object = std::get<JsonObject>(consumer.root());
+        const KeyTable::Symbol* symbol = object.begin()->first.symbol();
+        ASSERT_NE(symbol, nullptr);
+        EXPECT_EQ(symbol, table.find(long_key));
+        if (!first)
+            first = symbol;
+        EXPECT_EQ(symbol, first);
+        auto& nested = std::get<JsonObject>(std::get<JsonArray>(object.at(escaped_key))[0]);
+        EXPECT_EQ(nested.begin()->first.symbol(), symbol);
+        // past the hash threshold, looked up by string or by symbol
+        EXPECT_EQ(std::get<int64_t>(object.at("k16")), 16);
+        EXPECT_EQ(std::get<int64_t>(object.find(JsonKey(*table.find("k7")))->second), 7);
+        EXPECT_EQ(table.find(escaped_key)->name, escaped_key);
+    }
+
+    // a full table leaves the new keys owned
+    KeyTable small(1);
+    JsonConsumer bounded;
+    bounded.set_key_table(&small);
+    ValueParser<JsonConsumer> vp(bounded);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+    EXPECT_EQ(small.size(), 1u);
+    auto& object = std::get<JsonObject>(bounded.root());
+    EXPECT_NE(object.begin()->first.symbol(), nullptr);
+    EXPECT_EQ((object.begin() + 1)->first.symbol(), nullptr);
+    EXPECT_EQ((object.begin() + 1)->first, escaped_key);
+    EXPECT_EQ(std::get<int64_t>(object.at("k16")), 16);
+    // interned and owned keys compare by content
+    EXPECT_EQ(JsonKey(*small.find(long_key)), JsonKey(long_key));
+    EXPECT_FALSE(JsonKey(*small.find(long_key)) == JsonKey(escaped_key));
+}
+
+TEST(ConsumerTests, Numbers) {
+    const std::string input = "[0,-1,9223372036854775807,-9223372036854775808,9223372036854775808,"
+        "18446744073709551615,18446744073709551616,3.25,-1.5e-3,1E2]";
+
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+    auto& array = std::get<JsonArray>(consumer.root());
+    ASSERT_EQ(array.size(), 10u);
+    EXPECT_EQ(std::get<int64_t>(array[0]), 0);
+    EXPECT_EQ(std::get<int64_t>(array[1]), -1);
+    EXPECT_EQ(std::get<int64_t>(array[2]), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(std::get<int64_t>(array[3]), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(std::get<uint64_t>(array[4]), uint64_t{1} << 63);
+    EXPECT_EQ(std::get<uint64_t>(array[5]), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(std::get<double>(array[6]), 18446744073709551616.0);
+    EXPECT_EQ(std::get<double>(array[7]), 3.25);
+    EXPECT_EQ(std::get<double>(array[8]), -1.5e-3);
+    EXPECT_EQ(std::get<double>(array[9]), 100.0);
+
+    // lazy: the text is kept, whole or cut by chunks, and converted the same
+    // way when read
+    for (bool chunked: {false, true}) {
+        JsonConsumer lazy;
+        lazy.set_lazy_numbers(true);
+        ASSERT_EQ(parse_dom(lazy, input, chunked), ParseResult::ok);
+        std::stringstream ss;
+        to_string(lazy.root(), ss);
+        EXPECT_EQ(ss.str(), input);
+
+        auto& raw = std::get<JsonArray>(lazy.root());
+        ASSERT_EQ(raw.size(), 10u);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[3]).text(), "-9223372036854775808");
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[3]).as_int64(), std::numeric_limits<int64_t>::min());
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[3]).as_uint64(), std::nullopt);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[2]).as_uint64(), uint64_t(std::numeric_limits<int64_t>::max()));
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[5]).as_int64(), std::nullopt);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[5]).as_uint64(), std::numeric_limits<uint64_t>::max());
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[6]).as_uint64(), std::nullopt);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[6]).as_double(), 18446744073709551616.0);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[8]).text(), "-1.5e-3");
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[8]).as_double(), -1.5e-3);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[9]).as_int64(), std::nullopt);
+        EXPECT_EQ(std::get<JsonRawNumber>(raw[1]).as_double(), -1.0);
+    }
+}
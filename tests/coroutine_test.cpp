@@ -0,0 +1,137 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/coroutine.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+// started at once, destroyed when it returns
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+std::vector<std::string> chunks(const std::string& input, size_t size) {
+    std::vector<std::string> out;
+    for (size_t i = 0; i < input.size(); i += size)
+        out.push_back(input.substr(i, size));
+    return out;
+}
+
+// the documents as JSON text, then the result that ended the stream
+Task reader(AsyncParser<JsonConsumer>& parser, JsonConsumer& consumer, std::vector<std::string>& documents) {
+    ParseResult r;
+    while ((r = co_await parser.document()) == ParseResult::ok)
+        documents.push_back(to_json(consumer.root()));
+    documents.push_back(r == ParseResult::error ? "error" : "end");
+}
+
+// each chunk is overwritten once consumed, as a read buffer would be
+Task producer(AsyncParser<JsonConsumer>& parser, std::vector<std::string> input, bool& done) {
+    for (std::string& chunk: input) {
+        co_await parser.feed(chunk);
+        std::fill(chunk.begin(), chunk.end(), '#');
+    }
+    co_await parser.close();
+    done = true;
+}
+
+std::string str(const JsonEvent& e) {
+    switch (e.type) {
+        case JsonEvent::Type::object_begin: return "{";
+        case JsonEvent::Type::object_end: return "}";
+        case JsonEvent::Type::array_begin: return "[";
+        case JsonEvent::Type::array_end: return "]";
+        case JsonEvent::Type::key: return "k(" + std::string(e.text) + ")";
+        case JsonEvent::Type::string: return "s(" + std::string(e.text) + ")";
+        case JsonEvent::Type::number: return "n(" + std::string(e.text) + ")";
+        case JsonEvent::Type::boolean: return e.boolean ? "T" : "F";
+        case JsonEvent::Type::null: return "N";
+        case JsonEvent::Type::error: return "!";
+    }
+    return "?";
+}
+
+} // namespace
+
+
+TEST(CoroutineTests, Documents)
+{
+    struct Test {
+        std::string input;
+        std::vector<std::string> documents;
+    }
+    tests[]{
+        {R"({"a":1} [2,3]"x"{} 42 true)", {R"({"a":1})", "[2,3]", R"("x")", "{}", "42", "true", "end"}},
+        {"  ", {"end"}},
+        {"", {"end"}},
+        {R"({"a":1} [2,,3] 4)", {R"({"a":1})", "error"}},
+        {"[1,2", {"error"}},
+        {"-", {"error"}},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {1, 3, 7, 100}) {
+            for (bool reader_first: {true, false}) {
+                SCOPED_TRACE(t.input + " chunk " + std::to_string(chunk) + (reader_first ? " reader first" : ""));
+                JsonConsumer consumer;
+                AsyncParser<JsonConsumer> parser(consumer);
+                std::vector<std::string> documents;
+                bool done = false;
+                if (reader_first) {
+                    reader(parser, consumer, documents);
+                    producer(parser, chunks(t.input, chunk), done);
+                } else {
+                    producer(parser, chunks(t.input, chunk), done);
+                    reader(parser, consumer, documents);
+                }
+                EXPECT_EQ(documents, t.documents);
+                EXPECT_TRUE(done);
+            }
+        }
+    }
+}
+
+TEST(CoroutineTests, Events)
+{
+    struct Test {
+        std::string input;
+        std::string events;
+    }
+    tests[]{
+        {R"( {"a":[1,"x\"y",true,null],"bA":-2.5e3} )", "{k(a)[n(1)s(x\"y)TN]k(bA)n(-2.5e3)}"},
+        {"12", "n(12)"},
+        {"[false,{}]", "[F{}]"},
+        {"[1,}", "[n(1)!"},
+        {"[1] 2", "[n(1)]!"},
+        {"[1", "[n(1)!"},
+        {"", "!"},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {1, 2, 5, 100}) {
+            SCOPED_TRACE(t.input + " chunk " + std::to_string(chunk));
+            std::string events;
+            for (const JsonEvent& e: json_events(chunks(t.input, chunk)))
+                events += str(e);
+            EXPECT_EQ(events, t.events);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/document_stream.h>
+
+#include "event_consumer.h"
+
+using namespace libacpp::json;
+using libacpp::json::test::EventConsumer;
+using libacpp::json::test::parse_chunked;
+
+namespace {
+
+// the hooks, as a string: "<" begin, ">" end, "!offset" error
+struct Handler {
+    void document_begin() { log += "<"; }
+    void document_end() { log += ">"; }
+    void document_error(uint64_t offset) { log += "!" + std::to_string(offset); }
+    std::string log;
+};
+
+// the documents of a JsonConsumer, as JSON text
+struct Collector {
+    void document_end() { documents.push_back(to_json(consumer.root())); }
+    JsonConsumer& consumer;
+    std::vector<std::string> documents = {};
+};
+
+} // namespace
+
+
+TEST(DocumentStreamTests, Framing)
+{
+    struct Test {
+        Framing framing;
+        std::string input;
+        std::string events;
+        std::string log;
+        ParseResult finish = ParseResult::ok;
+    }
+    tests[]{
+        {Framing::lines, "", "", ""},
+        {Framing::lines, "\n\n  \r\n", "", ""},
+        {Framing::lines, "{\"a\":1}\n[2]\n3\n\"x\"\n", "{k(a)n(1)}[n(2)]n(3)s(x)", "<><><><>"},
+        {Framing::lines, "{\"a\":1}\r\n\r\n[true]", "{k(a)n(1)}[T]", "<><>"},
+        {Framing::lines, "1\n-2.5", "n(1)n(-2.5)", "<><>"},
+        {Framing::lines, "[1]  \n[2] \r\n", "[n(1)][n(2)]", "<><>"},
+        // malformed records
+        {Framing::lines, "[1] [2]\n", "[n(1)]", "<!4"},
+        {Framing::lines, "12a\n[3]\n", "n(12)[n(3)]", "<!2<>"},
+        {Framing::lines, "12a\n", "n(12)", "<!2"},
+        {Framing::lines, "{} x", "{}", "<!3"},
+        {Framing::lines, "{\"a\":1}\n{\"a\":}\n[3]\n", "{k(a)n(1)}{k(a)[n(3)]", "<><!13<>"},
+        {Framing::lines, "{\"a\":\n[2]\n", "{k(a)[n(2)]", "<!5<>"},
+        {Framing::lines, "]\nnull\n", "N", "<!0<>"},
+        {Framing::lines, "[1,\n", "[n(1)", "<!3", ParseResult::ok},
+        {Framing::lines, "[1,", "[n(1)", "<!3", ParseResult::error},
+        {Framing::concatenated, "{}{}[1]\"a\" 1 2 true", "{}{}[n(1)]s(a)n(1)n(2)T", "<><><><><><><>"},
+        {Framing::concatenated, "{\n  \"a\": 1\n}\n{\"b\":\n2}", "{k(a)n(1)}{k(b)n(2)}", "<><>"},
+        {Framing::concatenated, "{\"a\":1} ]x\n{\"b\":2}", "{k(a)n(1)}{k(b)n(2)}", "<><!8<>"},
+        {Framing::concatenated, "[1, 2", "[n(1)", "<!5", ParseResult::error},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {0, 1, 2, 3, 7}) {
+            SCOPED_TRACE(t.input + " chunk " + std::to_string(chunk));
+            EventConsumer consumer;
+            Handler handler;
+            DocumentStream<EventConsumer, Handler> stream(consumer, handler, t.framing);
+            EXPECT_EQ(parse_chunked(stream, t.input, chunk), ParseResult::partial);
+            EXPECT_EQ(stream.finish(), t.finish);
+            EXPECT_EQ(handler.log, t.log);
+            if (t.log.find('!') == std::string::npos) {
+                EXPECT_EQ(consumer.events(), t.events);
+            }
+            EXPECT_EQ(stream.offset(), t.input.size());
+            EXPECT_EQ(stream.documents() + stream.errors(),
+                static_cast<uint64_t>(std::count(t.log.begin(), t.log.end(), '<')));
+        }
+    }
+}
+
+TEST(DocumentStreamTests, JsonConsumer)
+{
+    const std::string input = "{\"id\":1,\"tags\":[\"a\"]}\n{\"id\":\n{\"id\":3}\n[]\n";
+    for (size_t chunk: {0, 1, 5}) {
+        JsonConsumer consumer;
+        Collector collector{consumer};
+        DocumentStream<JsonConsumer, Collector> stream(consumer, collector);
+        EXPECT_EQ(parse_chunked(stream, input, chunk), ParseResult::partial);
+        EXPECT_EQ(stream.finish(), ParseResult::ok);
+        EXPECT_EQ(collector.documents, (std::vector<std::string>{R"({"id":1,"tags":["a"]})", R"({"id":3})", "[]"}));
+        EXPECT_EQ(stream.documents(), 3u);
+        EXPECT_EQ(stream.errors(), 1u);
+
+        // the parser, the consumer and the stream are reused
+        stream.reset();
+        collector.documents.clear();
+        EXPECT_EQ(parse_chunked(stream, "7\n", chunk), ParseResult::partial);
+        EXPECT_EQ(stream.finish(), ParseResult::ok);
+        EXPECT_EQ(collector.documents, std::vector<std::string>{"7"});
+        EXPECT_EQ(stream.documents(), 1u);
+        EXPECT_EQ(stream.errors(), 0u);
+    }
+
+    // a JsonWriter is reset for each document: one line each, no commas
+    WriteBuffer out;
+    JsonWriter writer(out);
+    DocumentStream<JsonWriter> stream(writer, Framing::concatenated);
+    const std::string docs = "{ \"a\" : [1, 2] }  {\"b\": null}";
+    const char* p = docs.data();
+    stream.parse(p, p + docs.size());
+    EXPECT_EQ(out.view(), R"({"a":[1,2]}{"b":null})");
+}
@@ -0,0 +1,80 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include <libacpp-json/parse_result.h>
+
+namespace libacpp::json::test {
+
+// Feeds the whole input to parser, chunk bytes at a time (0: at once),
+// until it returns something other than partial.
+template <typename Parser>
+ParseResult parse_chunked(Parser& parser, const std::string& input, size_t chunk) {
+    const char* p = input.data();
+    const char* end = p + input.size();
+    ParseResult r = ParseResult::partial;
+    while (p != end && r == ParseResult::partial) {
+        const char* chunk_end = chunk == 0 ? end : std::min(p + chunk, end);
+        r = parser.parse(p, chunk_end);
+    }
+    return r;
+}
+
+// Records every consumer call as a compact string so that two engines can be
+// compared event by event. Scalars are only recorded when they end, so an
+// engine may begin a scalar it then abandons.
+class EventConsumer {
+public:
+    void string_begin() { scalar_.clear(); }
+    void add_char_string(char c) { scalar_.push_back(c); }
+    void string_end() { events_ += "s(" + scalar_ + ")"; }
+
+    void key_begin() { scalar_.clear(); }
+    void add_char_key(char c) { scalar_.push_back(c); }
+    void key_end() { events_ += "k(" + scalar_ + ")"; }
+
+    void number_begin() { scalar_.clear(); }
+    void sign(int s) { scalar_ += s < 0 ? "-" : "+"; }
+    void add_char_int(char c) { scalar_.push_back(c); }
+    void add_char_frac(char c) { scalar_ += "."; scalar_.push_back(c); }
+    void add_char_exp(char c) { scalar_ += "e"; scalar_.push_back(c); }
+    void number_end() { events_ += "n(" + scalar_ + ")"; }
+
+    void set_bool(bool v) { events_ += v ? "T" : "F"; }
+    void set_null() { events_ += "N"; }
+
+    void object_begin() { events_ += "{"; }
+    void object_end() { events_ += "}"; }
+    void array_begin() { events_ += "["; }
+    void array_end() { events_ += "]"; }
+
+    typedef EventConsumer KeyConsumerType;
+    typedef EventConsumer ValueConsumerType;
+    typedef EventConsumer KeyValueConsumerType;
+    typedef EventConsumer NumberConsumerType;
+    typedef EventConsumer StringConsumerType;
+    typedef EventConsumer ObjectConsumerType;
+    typedef EventConsumer ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+
+    const std::string& events() const { return events_;}
+
+private:
+    std::string scalar_;
+    std::string events_;
+};
+
+} // namespace libacpp::json::test
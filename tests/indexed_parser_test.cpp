@@ -0,0 +1,217 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <libacpp-json/indexed_parser.h>
+#include <libacpp-json/simd.h>
+#include <libacpp-json/stack_parser.h>
+
+#include "event_consumer.h"
+
+using namespace libacpp::json;
+using libacpp::json::test::EventConsumer;
+
+namespace {
+
+std::vector<uint32_t> structurals(simd::find_structurals_fn fn, const std::string& input, bool& closed) {
+    std::vector<uint32_t> out(input.size() + simd::structurals_padding);
+    uint32_t* last = fn(input.data(), input.data() + input.size(), out.data());
+    closed = last != nullptr;
+    out.resize(closed ? last - out.data() : 0);
+    return out;
+}
+
+} // namespace
+
+
+TEST(IndexedParserTests, StructuralIndex)
+{
+    struct Test {
+        std::string input;
+        bool closed;
+        std::vector<uint32_t> positions;
+    }
+    tests[]{
+        {"", true, {}},
+        {"  ", true, {}},
+        {"123", true, {0}},
+        {R"({"a":1})", true, {0, 1, 4, 5, 6}},
+        {R"([ true , -1.5e3 ])", true, {0, 2, 7, 9, 16}},
+        {R"("a,b:[c]")", true, {0}},
+        {R"("a\"b", "c\\", 1)", true, {0, 6, 8, 13, 15}},
+        {R"("\\\"" x)", true, {0, 7}},
+        {R"({"k":nullx})", true, {0, 1, 4, 5, 10}},
+        {R"("abc)", false, {}},
+        {R"(["a\"])", false, {}},
+    };
+    simd::find_structurals_fn kernels[]{simd::find_structurals_scalar,
+        simd::find_structurals_sse2, simd::find_structurals_avx2};
+    for (const auto& t: tests) {
+        for (auto kernel: kernels) {
+            if (kernel == simd::find_structurals_avx2 && !simd::has_avx2())
+                continue;
+            bool closed;
+            auto positions = structurals(kernel, t.input, closed);
+            EXPECT_EQ(closed, t.closed) << t.input;
+            EXPECT_EQ(positions, t.positions) << t.input;
+        }
+    }
+
+    // the vector kernels against the byte at a time one, on inputs dense in
+    // quotes and backslash runs crossing the 64 byte blocks
+    const char alphabet[] = "{}[]:, \t\n\"\"\\\\\\a1-";
+    std::mt19937 rng(1);
+    for (int i = 0; i < 2000; ++i) {
+        std::string input;
+        size_t size = rng() % 300;
+        for (size_t j = 0; j < size; ++j)
+            input.push_back(alphabet[rng() % (sizeof(alphabet) - 1)]);
+        bool expected_closed;
+        auto expected = structurals(simd::find_structurals_scalar, input, expected_closed);
+        for (auto kernel: kernels) {
+            if (kernel == simd::find_structurals_avx2 && !simd::has_avx2())
+                continue;
+            bool closed;
+            auto positions = structurals(kernel, input, closed);
+            EXPECT_EQ(closed, expected_closed) << input;
+            EXPECT_EQ(positions, expected) << input;
+        }
+    }
+}
+
+
+TEST(IndexedParserTests, SameEventsAsStackParser)
+{
+    std::string long_string(200, 'x');
+    std::string inputs[]{
+        "null",
+        " true ",
+        "false",
+        "[0,-12.5e+3]",
+        R"("abc\nA")",
+        "[]",
+        "{ }",
+        "[1,2]",
+        R"([{"a":1}])",
+        R"({"a":{"b":1},"c":2})",
+        R"([[1,2],[3],[]])",
+        R"({"a":[1,{"x":2}],"b":{}})",
+        R"({ "key1" : [null, 123.45e-67, true, false, "abc"], "key2" : { "key3" : "abcd", "key4" : { } } })",
+        "{\n  \"esc\" : \"a\\\"b\\\\\",\n  \"list\" : [\n    1,\n    \"" + long_string + "\"\n  ]\n}\n",
+        "[[[[[[[[[[\"deep\"]]]]]]]]]]",
+    };
+    for (const auto& input: inputs) {
+        EventConsumer expected;
+        StackParser<EventConsumer> sp{expected};
+        const char* p = input.data();
+        EXPECT_EQ(sp.parse(p, p + input.size()), ParseResult::ok) << input;
+
+        EventConsumer actual;
+        IndexedParser<EventConsumer> ip{actual};
+        EXPECT_EQ(ip.parse(input.data(), input.data() + input.size()), ParseResult::ok) << input;
+        EXPECT_EQ(actual.events(), expected.events()) << input;
+    }
+}
+
+
+// the escapes and the control bytes are checked by StringParser, the same
+// way for every engine and every path through it (raw views, spans, chars)
+TEST(IndexedParserTests, StringEscapes)
+{
+    struct Test {
+        std::string input;
+        ParseResult parseResult;
+    }
+    tests[]{
+        {R"(["\"\\\/\b\f\n\r\t\u0041"])", ParseResult::ok},
+        {R"({"k\/ey":"v\b"})", ParseResult::ok},
+        {R"(["\a"])", ParseResult::error},
+        {R"({"\x":1})", ParseResult::error},
+        {R"(["\u12"])", ParseResult::error},
+        {"[\"a\tb\"]", ParseResult::error},
+        {"{\"a\nb\":1}", ParseResult::error},
+        {std::string("[\"\x1f\"]"), ParseResult::error},
+    };
+    for (const auto& t: tests) {
+        EventConsumer indexed;
+        IndexedParser<EventConsumer> ip{indexed};
+        EXPECT_EQ(ip.parse(t.input.data(), t.input.data() + t.input.size()), t.parseResult) << t.input;
+        for (size_t chunk: {t.input.size(), size_t{1}}) {
+            EventConsumer stack;
+            StackParser<EventConsumer> sp{stack};
+            EventConsumer value;
+            ValueParser<EventConsumer> vp{value};
+            ParseResult rs = ParseResult::partial;
+            ParseResult rv = ParseResult::partial;
+            for (size_t i = 0; i < t.input.size(); i += chunk) {
+                const char* end = t.input.data() + std::min(i + chunk, t.input.size());
+                const char* p = t.input.data() + i;
+                if (rs == ParseResult::partial)
+                    rs = sp.parse(p, end);
+                p = t.input.data() + i;
+                if (rv == ParseResult::partial)
+                    rv = vp.parse(p, end);
+            }
+            EXPECT_EQ(rs, t.parseResult) << t.input << " chunk: " << chunk;
+            EXPECT_EQ(rv, t.parseResult) << t.input << " chunk: " << chunk;
+            if (t.parseResult == ParseResult::ok) {
+                EXPECT_EQ(stack.events(), indexed.events()) << t.input;
+                EXPECT_EQ(value.events(), indexed.events()) << t.input;
+            }
+        }
+    }
+}
+
+TEST(IndexedParserTests, Errors)
+{
+    struct Test {
+        std::string input;
+        ParseResult parseResult;
+    }
+    tests[]{
+        {"", ParseResult::partial},
+        {"{null}", ParseResult::error},
+        {"[1 2]", ParseResult::error},
+        {"[1,]", ParseResult::error},
+        {"[,1]", ParseResult::error},
+        {R"({"a" 1})", ParseResult::error},
+        {R"({"a":1,})", ParseResult::error},
+        {R"({"a":1])", ParseResult::error},
+        {R"({"a":1}})", ParseResult::error},
+        {R"({"a":nullx})", ParseResult::error},
+        {R"(["a""b"])", ParseResult::error},
+        {"[12a]", ParseResult::error},
+        {"x", ParseResult::error},
+        {"nUll", ParseResult::error},
+        {"1 2", ParseResult::error},
+        {"[", ParseResult::partial},
+        {"[1,", ParseResult::partial},
+        {"[tr", ParseResult::partial},
+        {R"({"a")", ParseResult::partial},
+        {R"({"a":)", ParseResult::partial},
+        {R"({"a":"b)", ParseResult::partial},
+    };
+    for (const auto& t: tests) {
+        EventConsumer consumer;
+        IndexedParser<EventConsumer> ip{consumer};
+        EXPECT_EQ(ip.parse(t.input.data(), t.input.data() + t.input.size()), t.parseResult) << t.input;
+    }
+
+    // nesting limit, and reuse of the same parser (and index) afterwards
+    std::string deep = std::string(40, '[') + "1" + std::string(40, ']');
+    EventConsumer consumer;
+    IndexedParser<EventConsumer> shallow{consumer, 39};
+    EXPECT_EQ(shallow.parse(deep.data(), deep.data() + deep.size()), ParseResult::error);
+    IndexedParser<EventConsumer> enough{consumer, 40};
+    EXPECT_EQ(enough.parse(deep.data(), deep.data() + deep.size()), ParseResult::ok);
+    std::string doc = "[[1]]";
+    EXPECT_EQ(enough.parse(doc.data(), doc.data() + doc.size()), ParseResult::ok);
+    EXPECT_EQ(consumer.events().substr(consumer.events().size() - 8), "[[n(1)]]");
+}
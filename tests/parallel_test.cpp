@@ -0,0 +1,226 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/document_stream.h>
+#include <libacpp-json/parallel.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+// the documents of each slice as JSON text, "!" for a malformed record
+struct Worker {
+    Worker(): stream(consumer, *this) {}
+
+    std::vector<std::string> parse(std::string_view slice) {
+        const char* p = slice.data();
+        stream.parse(p, p + slice.size());
+        stream.finish();
+        return std::move(documents);
+    }
+
+    void document_end() { documents.push_back(to_json(consumer.root())); }
+    void document_error(uint64_t) { documents.push_back("!"); }
+
+    JsonConsumer consumer;
+    DocumentStream<JsonConsumer, Worker> stream;
+    std::vector<std::string> documents;
+};
+
+struct Throwing {
+    int parse(std::string_view slice) {
+        if (slice.find("bad") != std::string_view::npos)
+            throw std::runtime_error("bad slice");
+        return 0;
+    }
+};
+
+std::string record(size_t i) {
+    return i % 7 == 3 ? "{\"id\":" : "{\"id\":" + std::to_string(i) + ",\"tags\":[\"t" + std::to_string(i % 5) + "\"]}";
+}
+
+} // namespace
+
+
+TEST(ParallelTests, SplitLines)
+{
+    const std::string input = "aa\nbbbb\nc\n\ndd";
+    struct Test {
+        size_t slice_size;
+        std::vector<std::string_view> slices;
+    }
+    tests[]{
+        {1, {"aa\n", "bbbb\n", "c\n", "\n", "dd"}},
+        {3, {"aa\n", "bbbb\n", "c\n\n", "dd"}},
+        {6, {"aa\nbbbb\n", "c\n\ndd"}},
+        {100, {"aa\nbbbb\nc\n\ndd"}},
+    };
+    for (const auto& t: tests)
+        EXPECT_EQ(split_lines(input, t.slice_size), t.slices) << t.slice_size;
+    EXPECT_TRUE(split_lines("", 10).empty());
+}
+
+TEST(ParallelTests, Lines)
+{
+    std::string input;
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < 2000; ++i) {
+        input += record(i) + "\n";
+        expected.push_back(i % 7 == 3 ? "!" : record(i));
+    }
+
+    for (bool ordered: {true, false}) {
+        for (size_t threads: {1, 2, 4}) {
+            for (size_t window: {1, 3, 0}) {
+                SCOPED_TRACE(std::to_string(ordered) + " threads " + std::to_string(threads)
+                    + " window " + std::to_string(window));
+                ParallelLineParser<Worker> parser({threads, 256, ordered, window});
+                std::vector<std::pair<size_t, std::vector<std::string>>> slices;
+                const size_t n = parser.parse(input, [&](size_t i, std::vector<std::string>&& documents) {
+                    slices.emplace_back(i, std::move(documents));
+                });
+                EXPECT_EQ(slices.size(), n);
+                if (!ordered)
+                    std::sort(slices.begin(), slices.end());
+                std::vector<std::string> documents;
+                for (size_t i = 0; i < slices.size(); ++i) {
+                    EXPECT_EQ(slices[i].first, i);
+                    documents.insert(documents.end(), slices[i].second.begin(), slices[i].second.end());
+                }
+                EXPECT_EQ(documents, expected);
+            }
+        }
+    }
+
+    // the threads wait between calls, and take part in each one
+    ParallelLineParser<Worker> parser({3, 64});
+    for (size_t round = 0; round < 5; ++round) {
+        size_t documents = 0;
+        const std::string_view lines = std::string_view(input).substr(0, input.find('\n', 100 * round) + 1);
+        const size_t n = parser.parse(lines, [&](size_t, std::vector<std::string>&& d) { documents += d.size(); });
+        EXPECT_EQ(n, split_lines(lines, 64).size());
+        EXPECT_EQ(documents, static_cast<size_t>(std::count(lines.begin(), lines.end(), '\n')));
+    }
+}
+
+TEST(ParallelTests, Errors)
+{
+    std::string input;
+    for (size_t i = 0; i < 100; ++i)
+        input += i == 60 ? "bad\n" : "good\n";
+    for (bool ordered: {true, false}) {
+        ParallelLineParser<Throwing> parser({3, 16, ordered, 2});
+        EXPECT_THROW(parser.parse(input, [](size_t, int) {}), std::runtime_error);
+        // deliver may throw as well; the parser is usable afterwards
+        EXPECT_THROW(parser.parse("good\ngood\n", [](size_t, int) { throw std::logic_error("deliver"); }),
+            std::logic_error);
+        size_t delivered = 0;
+        EXPECT_EQ(parser.parse("good\ngood\n", [&](size_t, int) { ++delivered; }), 1u);
+        EXPECT_EQ(delivered, 1u);
+    }
+}
+
+TEST(ParallelTests, Array)
+{
+    std::string objects = "[";
+    for (size_t i = 0; i < 300; ++i) {
+        if (i != 0)
+            objects += i % 2 ? ",\n  " : ",";
+        objects += "{\"id\":" + std::to_string(i);
+        // commas that look like splits, inside strings and nested arrays
+        if (i % 11 == 0)
+            objects += ",\"s\":\"},{\\\"},{\\\\\"";
+        if (i % 13 == 0)
+            objects += ",\"a\":[{\"x\":1},{\"y\":[2,3]}]";
+        objects += "}";
+    }
+    objects += "] ";
+
+    const std::string inputs[] = {
+        objects,
+        "[1,-2.5,3e2,true,null,false,4,5,6,7,8,9,10,11,12,13,14,15]",
+        R"(["a","b\"","c\\","d\",\"e","f","g","h","i","j","k","l"])",
+        "[[1,2],[3,[4,5]],[],[6],[7,8],[9],[10],[11],[12],[13]]",
+        "  [ 1 ]  ",
+        "[ ]",
+        "{\"a\":[1,2]}",
+        "12",
+    };
+    for (const std::string& input: inputs) {
+        JsonConsumer sequential;
+        ValueParser<JsonConsumer> parser(sequential);
+        const char* p = input.data() + input.find_first_not_of(' ');
+        const char* end = input.data() + input.size();
+        ParseResult r = parser.parse(p, end);
+        if (r == ParseResult::partial) {
+            const char* space = " ";
+            r = parser.parse(space, space + 1);
+        }
+        ASSERT_EQ(r, ParseResult::ok) << input;
+        const std::string expected = to_json(sequential.root());
+
+        for (size_t threads: {1, 3}) {
+            for (size_t slice_size: {1, 5, 64, 1000, 1 << 20}) {
+                SCOPED_TRACE(input.substr(0, 20) + " threads " + std::to_string(threads)
+                    + " slice " + std::to_string(slice_size));
+                JsonConsumer consumer;
+                ParallelArrayResult result = parse_array_parallel(input, consumer, {threads, slice_size});
+                EXPECT_EQ(result.result, ParseResult::ok);
+                EXPECT_EQ(to_json(consumer.root()), expected);
+                if (slice_size >= input.size()) {
+                    EXPECT_TRUE(result.sequential);
+                }
+            }
+        }
+    }
+
+    // the guesses inside strings and nested arrays are caught, and the
+    // ranges after them still used
+    JsonConsumer consumer;
+    ParallelArrayResult result = parse_array_parallel(objects, consumer, {2, 64});
+    EXPECT_TRUE(result.sequential);
+    EXPECT_GT(result.ranges, 10u);
+}
+
+TEST(ParallelTests, ArrayErrors)
+{
+    const std::string inputs[] = {
+        "[1,2,3,,4,5,6,7,8]",
+        "[{\"a\":1},{\"b\":2},{\"c\":3},{\"d\":}]",
+        "[{\"a\":1},{\"b\":2},{\"c\":3},{\"d\":4}",
+        "[{\"a\":1},{\"b\":2} {\"c\":3},{\"d\":4}]",
+        "[\"a\",\"b\",\"c\",\"d\",\"e],[\"f\"]",
+        "[1,2,3,4,5,6,7,8] 9",
+        "[1,2,3,4,5,6,7,8, ]",
+        "[{\"a\":1},{\"b\":2},{\"c\":3},]",
+        "",
+    };
+    for (const std::string& input: inputs) {
+        for (size_t slice_size: {1, 4, 1 << 20}) {
+            SCOPED_TRACE(input + " slice " + std::to_string(slice_size));
+            JsonConsumer consumer;
+            EXPECT_EQ(parse_array_parallel(input, consumer, {2, slice_size}).result, ParseResult::error);
+        }
+    }
+
+    // consumers with an arena are parsed sequentially
+    JsonArena arena;
+    JsonConsumer consumer(arena);
+    ParallelArrayResult result = parse_array_parallel("[1,2,3,4,5,6,7,8]", consumer, {2, 2});
+    EXPECT_EQ(result.result, ParseResult::ok);
+    EXPECT_TRUE(result.sequential);
+    EXPECT_EQ(result.ranges, 0u);
+    EXPECT_EQ(to_json(consumer.root()), "[1,2,3,4,5,6,7,8]");
+    consumer.reset();
+}
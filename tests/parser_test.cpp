@@ -6,6 +6,14 @@
 
 #include <gtest/gtest.h> 
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <variant>
+#include <vector>
+
 #include "libacpp-json/log.h"
 
 #include <libacpp-json/parser.h>
@@ -208,6 +216,8 @@ struct Test {
     {R"("hello\\world!")", ParseResult::ok, "hello\\world!"}, 
     {R"("hello world! \u00f1")", ParseResult::ok, "hello world! ñ"}, 
     {R"("\u0041 \u0042 \u0043 \u0044")", ParseResult::ok, "A B C D"}, 
+    {R"("say \"hi\" \/ \b\f")", ParseResult::ok, "say \"hi\" / \b\f"}, 
+    {R"("hello\qworld!")", ParseResult::error, "hello"}, 
 };
     if (sync_test)
         for(const auto& t: tests) {
@@ -226,8 +236,8 @@ struct Test {
             StringParser<JsonConsumer> sp{consumer};
             const char* p = t.input.data();
             const char* end = p + t.input.size();
-            ParseResult r;
-            while (p != end) {
+            ParseResult r = ParseResult::partial;
+            while (p != end && r == ParseResult::partial) {
                 r = sp.parse(p, p+1);
             }
             EXPECT_EQ(r, t.parseResult) << "test 1";
@@ -237,6 +247,244 @@ struct Test {
         }
 }
 
+TEST(ParserTests, StringEscapes)
+{
+struct Test {
+    std::string input;
+    ParseResult parseResult;
+    std::string result;
+}tests[]{
+    {R"("\"\\\/\b\f\n\r\t")", ParseResult::ok, "\"\\/\b\f\n\r\t"},
+    {R"("a\u00e9\u20ACb")", ParseResult::ok, "a\u00e9\u20ACb"},
+    {R"("\a")", ParseResult::error, ""},
+    {R"("x\x41")", ParseResult::error, "x"},
+    {R"("x\'")", ParseResult::error, "x"},
+    {R"("\u00g1")", ParseResult::error, ""},
+    {"\"tab\there\"", ParseResult::error, "tab"},
+    {"\"line\nbreak\"", ParseResult::error, "line"},
+    {std::string("\"nul\0\"", 6), ParseResult::error, "nul"},
+    {"\"del\x7f is fine\"", ParseResult::ok, "del\x7f is fine"},
+};
+    for (const auto& t: tests) {
+        for (size_t chunk: {t.input.size(), size_t{1}}) {
+            JsonConsumer consumer;
+            StringParser<JsonConsumer, false> sp{consumer};
+            const char* p = t.input.data();
+            const char* end = p + t.input.size();
+            ParseResult r = ParseResult::partial;
+            while (p != end && r == ParseResult::partial)
+                r = sp.parse(p, std::min(p + chunk, end));
+            EXPECT_EQ(r, t.parseResult) << t.input << " chunk: " << chunk;
+            EXPECT_EQ(sp.consumer().string_value(), t.result) << t.input << " chunk: " << chunk;
+        }
+    }
+}
+
+
+class SpanConsumer {
+public:
+    void string_begin() {
+        string_value_.clear();
+        spans_ = 0;
+        chars_ = 0;
+    }
+    void add_char_string(char c) {
+        string_value_.push_back(c);
+        ++chars_;
+    }
+    void add_chars_string(std::string_view s) {
+        string_value_.append(s);
+        ++spans_;
+    }
+    void string_end() {}
+
+    std::string string_value() { return string_value_;}
+    int spans() { return spans_;}
+    int chars() { return chars_;}
+
+private:
+    std::string string_value_;
+    int spans_ = 0;
+    int chars_ = 0;
+};
+
+TEST(ParserTests, StringSpan)
+{
+std::string long_run(100, 'a');
+struct Test {
+    std::string input;
+    ParseResult parseResult;
+    std::string result;
+    int spans;
+    int chars;
+}tests[]{
+    {R"("hello")", ParseResult::ok, "hello", 1, 0},
+    {R"("")", ParseResult::ok, "", 0, 0},
+    {R"("hello)", ParseResult::partial, "hello", 1, 0},
+    {R"("hello\tworld!")", ParseResult::ok, "hello\tworld!", 2, 1},
+    {R"("\\\\")", ParseResult::ok, "\\\\", 0, 2},
+    {R"("hello world! \u00f1")", ParseResult::ok, "hello world! ñ", 1, 2},
+    {R"("hello world! ñ")", ParseResult::ok, "hello world! ñ", 1, 0},
+    {"\"" + long_run + "\\n" + long_run + "\"", ParseResult::ok, long_run + "\n" + long_run, 2, 1},
+    {"\"" + long_run + "\x01" + long_run + "\"", ParseResult::error, long_run, 1, 0},
+};
+    for(const auto& t: tests) {
+        SpanConsumer consumer;
+        StringParser<SpanConsumer, false> sp{consumer};
+        const char* p = t.input.data();
+        auto r = sp.parse(p, p+t.input.size());
+        EXPECT_EQ(r, t.parseResult) << t.input;
+        EXPECT_EQ(consumer.string_value(), t.result) << t.input;
+        EXPECT_EQ(consumer.spans(), t.spans) << t.input;
+        EXPECT_EQ(consumer.chars(), t.chars) << t.input;
+    }
+    for (size_t chunk: {1, 2, 3, 7, 16, 33}) {
+        for(const auto& t: tests) {
+            SpanConsumer consumer;
+            StringParser<SpanConsumer, false> sp{consumer};
+            const char* p = t.input.data();
+            const char* end = p + t.input.size();
+            ParseResult r = ParseResult::partial;
+            while (p != end && r == ParseResult::partial) {
+                const char* chunk_end = std::min(p + chunk, end);
+                r = sp.parse(p, chunk_end);
+            }
+            EXPECT_EQ(r, t.parseResult) << t.input << " chunk: " << chunk;
+            EXPECT_EQ(consumer.string_value(), t.result) << t.input << " chunk: " << chunk;
+        }
+    }
+}
+
+
+class RawConsumer: public SpanConsumer {
+public:
+    void string_raw(std::string_view s, bool escaped) {
+        raw_ = s;
+        escaped_ = escaped;
+        ++raws_;
+    }
+
+    std::string_view raw() { return raw_;}
+    bool escaped() { return escaped_;}
+    int raws() { return raws_;}
+
+private:
+    std::string_view raw_;
+    bool escaped_ = false;
+    int raws_ = 0;
+};
+
+TEST(ParserTests, StringRaw)
+{
+struct Test {
+    std::string input;
+    ParseResult parseResult;
+    std::string raw;     // whole in the buffer: the view handed over
+    bool escaped;
+    std::string result;  // the decoded content
+}tests[]{
+    {R"("hello")", ParseResult::ok, "hello", false, "hello"},
+    {R"("")", ParseResult::ok, "", false, ""},
+    {R"("hello\tworld!")", ParseResult::ok, R"(hello\tworld!)", true, "hello\tworld!"},
+    {R"("say \"hi\" \/ \b\f")", ParseResult::ok, R"(say \"hi\" \/ \b\f)", true, "say \"hi\" / \b\f"},
+    {R"("\u0041 \u00f1")", ParseResult::ok, R"(\u0041 \u00f1)", true, "A ñ"},
+    {R"("\\")", ParseResult::ok, R"(\\)", true, "\\"},
+    // left to the state machine
+    {R"("hello)", ParseResult::partial, "", false, "hello"},
+    {R"("hello\qworld!")", ParseResult::error, "", false, "hello"},
+    {R"("bad \u00g1")", ParseResult::error, "", false, "bad "},
+    {"\"a\x01" "b\"", ParseResult::error, "", false, "a"},
+};
+    for(const auto& t: tests) {
+        RawConsumer consumer;
+        StringParser<RawConsumer, false> sp{consumer};
+        const char* p = t.input.data();
+        const char* end = p + t.input.size();
+        auto r = sp.parse(p, end);
+        EXPECT_EQ(r, t.parseResult) << t.input;
+        if (consumer.raws() == 0) {
+            EXPECT_EQ(t.raw, "") << t.input;
+            EXPECT_EQ(consumer.string_value(), t.result) << t.input;
+            continue;
+        }
+        EXPECT_EQ(consumer.raws(), 1) << t.input;
+        EXPECT_EQ(p, end) << t.input;
+        EXPECT_EQ(consumer.raw(), t.raw) << t.input;
+        EXPECT_EQ(consumer.raw().data(), t.input.data() + 1) << t.input;
+        EXPECT_EQ(consumer.escaped(), t.escaped) << t.input;
+        // deferred decoding goes through the same escape logic
+        RawConsumer decoded;
+        StringParser<RawConsumer, false> dp{decoded};
+        EXPECT_EQ(dp.parse_content(consumer.raw()), ParseResult::ok) << t.input;
+        EXPECT_EQ(decoded.string_value(), t.result) << t.input;
+    }
+    // cut by the end of the chunk: the usual char and span calls
+    for(const auto& t: tests) {
+        RawConsumer consumer;
+        StringParser<RawConsumer, false> sp{consumer};
+        const char* p = t.input.data();
+        const char* end = p + t.input.size();
+        ParseResult r = ParseResult::partial;
+        while (p != end && r == ParseResult::partial)
+            r = sp.parse(p, p + 1);
+        EXPECT_EQ(r, t.parseResult) << t.input;
+        EXPECT_EQ(consumer.raws(), 0) << t.input;
+        EXPECT_EQ(consumer.string_value(), t.result) << t.input;
+    }
+    RawConsumer consumer;
+    StringParser<RawConsumer, false> sp{consumer};
+    EXPECT_EQ(sp.parse_content(R"(cut \u00)"), ParseResult::error);
+    EXPECT_EQ(sp.parse_content(R"(trailing \)"), ParseResult::error);
+    EXPECT_EQ(sp.parse_content(R"(a"b)"), ParseResult::error);
+}
+
+
+TEST(ParserTests, WhiteSpace)
+{
+    struct Test {
+        std::string input;
+        ParseResult parseResult;
+        size_t consumed;
+    }
+    tests[]{
+        {"", ParseResult::partial, 0},
+        {"x", ParseResult::ok, 0},
+        {" x", ParseResult::ok, 1},
+        {" \t\r\nx", ParseResult::ok, 4},
+        {"    ", ParseResult::partial, 4},
+        {std::string(40, ' ') + "\n" + std::string(40, '\t') + "}", ParseResult::ok, 81},
+        {std::string(100, ' '), ParseResult::partial, 100},
+    };
+    for(const auto& t: tests) {
+        WhiteSpaceParser wsp;
+        const char* p = t.input.data();
+        auto r = wsp.parse(p, p + t.input.size());
+        EXPECT_EQ(r, t.parseResult) << "[" << t.input << "]";
+        EXPECT_EQ(p - t.input.data(), t.consumed) << "[" << t.input << "]";
+    }
+
+    // every kernel stops at the same byte, whatever the run length and the
+    // character that ends it
+    const char stops[] = {'x', '{', '\0', '\x0b', '\x80', ' ' + 1};
+    for (size_t n = 0; n < 70; ++n) {
+        for (char stop: stops) {
+            std::string s;
+            for (size_t i = 0; i < n; ++i)
+                s.push_back(" \t\n\r"[i % 4]);
+            s.push_back(stop);
+            const char* b = s.data();
+            const char* e = b + s.size();
+            EXPECT_EQ(simd::skip_whitespace_scalar(b, e), b + n);
+            EXPECT_EQ(simd::skip_whitespace_sse2(b, e), b + n);
+            if (simd::has_avx2()) {
+                EXPECT_EQ(simd::skip_whitespace_avx2(b, e), b + n);
+            }
+            EXPECT_EQ(simd::skip_whitespace(b, e), b + n);
+            EXPECT_EQ(simd::skip_whitespace(b, b + n), b + n);
+        }
+    }
+}
+
 
 TEST(ParserTests, Number)
 {
@@ -327,6 +575,158 @@ tests[]{
 }
 
 
+class NumberValueConsumer {
+public:
+    void number_value(int64_t v) { value_ = v; ++calls_;}
+    void number_value(uint64_t v) { value_ = v; ++calls_;}
+    void number_value(double v) { value_ = v; ++calls_;}
+
+    // type and exact bits, so that -0.0 and 0.0 differ
+    std::string value() {
+        char buffer[64];
+        if (auto v = std::get_if<int64_t>(&value_))
+            snprintf(buffer, sizeof(buffer), "i%lld", (long long)*v);
+        else if (auto v = std::get_if<uint64_t>(&value_))
+            snprintf(buffer, sizeof(buffer), "u%llu", (unsigned long long)*v);
+        else if (auto v = std::get_if<double>(&value_))
+            snprintf(buffer, sizeof(buffer), "d%a", *v);
+        else
+            return "none";
+        return buffer;
+    }
+    int calls() { return calls_;}
+
+private:
+    std::variant<std::monostate, int64_t, uint64_t, double> value_;
+    int calls_ = 0;
+};
+
+std::string number_value_of(int64_t v) { NumberValueConsumer c; c.number_value(v); return c.value();}
+std::string number_value_of(uint64_t v) { NumberValueConsumer c; c.number_value(v); return c.value();}
+std::string number_value_of(double v) { NumberValueConsumer c; c.number_value(v); return c.value();}
+
+TEST(ParserTests, NumberValue)
+{
+struct Test {
+    std::string input;
+    ParseResult parseResult;
+    std::string result;
+}tests[]{
+    {"0", ParseResult::ok, number_value_of(int64_t{0})},
+    {"-0", ParseResult::ok, number_value_of(int64_t{0})},
+    {"7", ParseResult::ok, number_value_of(int64_t{7})},
+    {"-123", ParseResult::ok, number_value_of(int64_t{-123})},
+    {"1234567890123", ParseResult::ok, number_value_of(int64_t{1234567890123})},
+    {"9223372036854775807", ParseResult::ok, number_value_of(std::numeric_limits<int64_t>::max())},
+    {"-9223372036854775808", ParseResult::ok, number_value_of(std::numeric_limits<int64_t>::min())},
+    {"9223372036854775808", ParseResult::ok, number_value_of(uint64_t{9223372036854775808ull})},
+    {"18446744073709551615", ParseResult::ok, number_value_of(std::numeric_limits<uint64_t>::max())},
+    {"18446744073709551616", ParseResult::ok, number_value_of(18446744073709551616.0)},
+    {"-9223372036854775809", ParseResult::ok, number_value_of(-9223372036854775809.0)},
+    {"123456789012345678901234567890", ParseResult::ok, number_value_of(123456789012345678901234567890.0)},
+    {"1.5", ParseResult::ok, number_value_of(1.5)},
+    {"-0.0", ParseResult::ok, number_value_of(-0.0)},
+    {"0.1", ParseResult::ok, number_value_of(0.1)},
+    {"0.30000000000000004", ParseResult::ok, number_value_of(0.30000000000000004)},
+    {"1e2", ParseResult::ok, number_value_of(100.0)},
+    {"1E-2", ParseResult::ok, number_value_of(0.01)},
+    {"-123.45e+67", ParseResult::ok, number_value_of(-123.45e+67)},
+    {"12345678.87654321e5", ParseResult::ok, number_value_of(12345678.87654321e5)},
+    {"9007199254740993", ParseResult::ok, number_value_of(int64_t{9007199254740993})},
+    {"9007199254740993.0", ParseResult::ok, number_value_of(9007199254740992.0)},
+    {"2.2250738585072011e-308", ParseResult::ok, number_value_of(2.2250738585072011e-308)},
+    {"4.9e-324", ParseResult::ok, number_value_of(4.9e-324)},
+    {"1.7976931348623157e308", ParseResult::ok, number_value_of(1.7976931348623157e308)},
+    {"1e400", ParseResult::ok, number_value_of(std::numeric_limits<double>::infinity())},
+    {"-1e400", ParseResult::ok, number_value_of(-std::numeric_limits<double>::infinity())},
+    {"1e-400", ParseResult::ok, number_value_of(0.0)},
+    {"0e99999999999", ParseResult::ok, number_value_of(0.0)},
+    {"0.000000000000000000000000000000000000000000001e45", ParseResult::ok, number_value_of(1.0)},
+    {"3.14159265358979323846264338327950288419716939937510", ParseResult::ok, number_value_of(3.14159265358979323846264338327950288419716939937510)},
+    {"01", ParseResult::error, "none"},
+    {"+1", ParseResult::error, "none"},
+    {".5", ParseResult::error, "none"},
+    {"1.", ParseResult::error, "none"},
+    {"1.e1", ParseResult::error, "none"},
+    {"1e", ParseResult::error, "none"},
+    {"1e+", ParseResult::error, "none"},
+    {"-", ParseResult::error, "none"},
+    {"-a", ParseResult::error, "none"},
+};
+    // a number ends on the next byte, or on finish() at the end of input;
+    // every split point exercises the digit-by-digit path across chunks
+    for(const auto& t: tests) {
+        for (std::string_view terminator: {"", " ", ","}) {
+            std::string input = t.input;
+            input += terminator;
+            for (size_t split = 0; split <= input.size(); ++split) {
+                NumberValueConsumer consumer;
+                NumberParser<NumberValueConsumer> np{consumer};
+                const char* p = input.data();
+                const char* end = p + input.size();
+                ParseResult r = np.parse(p, p + split);
+                if (r == ParseResult::partial)
+                    r = np.parse(p, end);
+                if (r == ParseResult::partial)
+                    r = np.finish();
+                EXPECT_EQ(r, t.parseResult) << input << " split: " << split;
+                if (t.parseResult == ParseResult::ok) {
+                    EXPECT_EQ(consumer.value(), t.result) << input << " split: " << split;
+                    EXPECT_EQ(consumer.calls(), 1) << input << " split: " << split;
+                    EXPECT_EQ(end - p, (long)terminator.size()) << input << " split: " << split;
+                }
+            }
+        }
+    }
+
+    // random numbers against strtod, including long mantissas and extreme
+    // exponents that leave the fast paths
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 20000; ++i) {
+        std::string input;
+        if (rng() % 2)
+            input += '-';
+        // mostly mantissas of up to 19 digits (Eisel-Lemire), some longer
+        bool long_mantissa = i % 4 == 0;
+        int int_digits = 1 + rng() % (long_mantissa ? 20 : 10);
+        input += (char)('1' + rng() % 9);
+        for (int d = 1; d < int_digits; ++d)
+            input += (char)('0' + rng() % 10);
+        input += '.';
+        int frac_digits = 1 + rng() % (long_mantissa ? 25 : 9);
+        for (int d = 0; d < frac_digits; ++d)
+            input += (char)('0' + rng() % 10);
+        input += 'e' + std::to_string((int)(rng() % 700) - 350);
+
+        std::string expected = number_value_of(std::strtod(input.c_str(), nullptr));
+
+        NumberValueConsumer consumer;
+        NumberParser<NumberValueConsumer> np{consumer};
+        const char* p = input.data();
+        EXPECT_EQ(np.parse(p, p + input.size()), ParseResult::partial) << input;
+        EXPECT_EQ(np.finish(), ParseResult::ok) << input;
+        EXPECT_EQ(consumer.value(), expected) << input;
+
+        std::string terminated = input + ",";
+        p = terminated.data();
+        EXPECT_EQ(np.parse(p, p + terminated.size()), ParseResult::ok) << input;
+        EXPECT_EQ(consumer.value(), expected) << input;
+    }
+}
+
+
+template <reflection::fixed_string Literal>
+ParseResult parse_literal(const std::string& value, size_t chunk, size_t& consumed) {
+    LiteralParser<Literal> lp;
+    const char* p = value.data();
+    const char* end = p + value.size();
+    ParseResult r = ParseResult::partial;
+    while (p != end && r == ParseResult::partial)
+        r = lp.parse(p, static_cast<size_t>(end - p) < chunk ? end : p + chunk);
+    consumed = static_cast<size_t>(p - value.data());
+    return r;
+}
+
 TEST(ParserTests, Literal)
 {
     struct Test {
@@ -340,39 +740,34 @@ TEST(ParserTests, Literal)
         {"false", "false", ParseResult::ok}, 
         {"Null", "null", ParseResult::error}, 
         {"nUll", "null", ParseResult::error}, 
+        {"nulL", "null", ParseResult::error}, 
+        {"falsE", "false", ParseResult::error}, 
         {"n", "null", ParseResult::partial}, 
+        {"tru", "true", ParseResult::partial}, 
+        {"fals", "false", ParseResult::partial}, 
         {"nullxxx", "null", ParseResult::ok}, 
+        {"false,", "false", ParseResult::ok}, 
     };
-    if (sync_test) {
-        JSON_LOG_DEBUG("first test");
-        for(const auto& t: tests) {
-            std::string result;
-            LiteralParser sp(t.literal);
-            const char* p = t.value.data();
-            auto r = sp.parse(p, p + t.value.size());
-            EXPECT_EQ(r, t.parseResult) << "test1 " << t.value;
-        }
-    }
-    if (async_test) {
-        JSON_LOG_DEBUG("second test");
+    auto parse = [](const Test& t, size_t chunk, size_t& consumed) {
+        if (t.literal == "null")
+            return parse_literal<"null">(t.value, chunk, consumed);
+        if (t.literal == "true")
+            return parse_literal<"true">(t.value, chunk, consumed);
+        return parse_literal<"false">(t.value, chunk, consumed);
+    };
+    std::vector<size_t> chunks;
+    if (sync_test)
+        chunks.push_back(std::numeric_limits<size_t>::max());
+    if (async_test)
+        chunks.insert(chunks.end(), {1, 2, 3});
+    for (size_t chunk: chunks) {
         for(const auto& t: tests) {
-            std::string result;
-            LiteralParser sp(t.literal);
-            const char* p = t.value.data();
-            const char* end = p + t.value.size();
-            ParseResult r = ParseResult::partial;
-            for(char c: t.value) {
-                char b[2];
-                b[0] = c;
-                b[1] = 0;
-                const char* p = &b[0];
-                const char* end = p+1;
-                r = sp.parse(p, end);
-                if (r != ParseResult::partial)
-                    break;
+            size_t consumed = 0;
+            auto r = parse(t, chunk, consumed);
+            EXPECT_EQ(r, t.parseResult) << t.value << " chunk: " << chunk;
+            if (r == ParseResult::ok) {
+                EXPECT_EQ(consumed, t.literal.size()) << t.value << " chunk: " << chunk;
             }
-
-            EXPECT_EQ(r, t.parseResult) << "test1 " << t.value << " " << (int)r << " " <<  (int)t.parseResult;
         }
     }
 }
@@ -479,6 +874,81 @@ TEST(ParserTests, Value)
 
 }
 
+// Counts the begin callbacks: a value must only start the sub-parser its
+// first byte selects.
+class BeginCounter {
+public:
+    void string_begin() { ++strings_; }
+    void add_char_string(char) {}
+    void string_end() {}
+    void key_begin() {}
+    void add_char_key(char) {}
+    void key_end() {}
+    void number_begin() { ++numbers_; }
+    void sign(int) {}
+    void add_char_int(char) {}
+    void add_char_frac(char) {}
+    void add_char_exp(char) {}
+    void number_end() {}
+    void set_bool(bool) {}
+    void set_null() {}
+    void object_begin() { ++objects_; }
+    void object_end() {}
+    void array_begin() { ++arrays_; }
+    void array_end() {}
+
+    typedef BeginCounter KeyConsumerType;
+    typedef BeginCounter ValueConsumerType;
+    typedef BeginCounter KeyValueConsumerType;
+    typedef BeginCounter NumberConsumerType;
+    typedef BeginCounter StringConsumerType;
+    typedef BeginCounter ObjectConsumerType;
+    typedef BeginCounter ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+
+    std::string counts() {
+        return std::to_string(strings_) + "/" + std::to_string(numbers_) + "/"
+            + std::to_string(objects_) + "/" + std::to_string(arrays_);
+    }
+
+private:
+    int strings_ = 0;
+    int numbers_ = 0;
+    int objects_ = 0;
+    int arrays_ = 0;
+};
+
+TEST(ParserTests, ValueDispatch)
+{
+    struct Test {
+        std::string input;
+        ParseResult parseResult;
+        std::string counts; // strings/numbers/objects/arrays begun
+    }
+    tests[]{
+        {"null", ParseResult::ok, "0/0/0/0"},
+        {"true", ParseResult::ok, "0/0/0/0"},
+        {"12 ", ParseResult::ok, "0/1/0/0"},
+        {R"("abc")", ParseResult::ok, "1/0/0/0"},
+        {R"({"a":"b"})", ParseResult::ok, "1/0/1/0"},
+        {R"(["a",1,{}])", ParseResult::ok, "1/1/1/1"},
+        {"Null", ParseResult::error, "0/0/0/0"},
+        {"}", ParseResult::error, "0/0/0/0"},
+    };
+    for(const auto& t: tests) {
+        BeginCounter consumer;
+        ValueParser<BeginCounter> vp(consumer);
+        const char* p = t.input.data();
+        EXPECT_EQ(vp.parse(p, p + t.input.size()), t.parseResult) << t.input;
+        EXPECT_EQ(consumer.counts(), t.counts) << t.input;
+    }
+}
+
 std::string key_value_to_string(JsonConsumer& c) {
     std::stringstream ss;
     ss << c.key() << "->" << to_string(c.value_consumer()) 
@@ -0,0 +1,140 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/path.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+JsonValue parse(const std::string& input) {
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    EXPECT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << input;
+    return std::move(consumer.root());
+}
+
+// the value at path as JSON text, "missing" when there is none
+std::string lookup(const JsonPath& path, const JsonValue& root) {
+    const JsonValue* v = path.find(root);
+    return v ? to_json(*v) : "missing";
+}
+
+} // namespace
+
+
+TEST(PathTests, Pointer)
+{
+    // the example of RFC 6901, section 5
+    const JsonValue doc = parse(R"({"foo": ["bar", "baz"], "": 0, "a/b": 1, "c%d": 2, "e^f": 3, "g|h": 4,
+        "i\\j": 5, "k\"l": 6, " ": 7, "m~n": 8, "nested": {"01": "key", "list": [{"x": null}]}})");
+    struct Test {
+        std::string pointer;
+        std::string result;
+    }
+    tests[]{
+        {"/foo", R"(["bar","baz"])"},
+        {"/foo/0", R"("bar")"},
+        {"/", "0"},
+        {"/a~1b", "1"},
+        {"/c%d", "2"},
+        {"/e^f", "3"},
+        {"/g|h", "4"},
+        {"/i\\j", "5"},
+        {"/k\"l", "6"},
+        {"/ ", "7"},
+        {"/m~0n", "8"},
+        {"/nested/01", R"("key")"},
+        {"/nested/list/0/x", "null"},
+        // missing
+        {"/foo/2", "missing"},
+        {"/foo/-", "missing"},
+        {"/foo/01", "missing"},
+        {"/foo/0/x", "missing"},
+        {"/bar", "missing"},
+        {"/nested/list/0/x/y", "missing"},
+    };
+    for (const auto& t: tests) {
+        JsonPath path = JsonPath::pointer(t.pointer);
+        EXPECT_EQ(lookup(path, doc), t.result) << t.pointer;
+        EXPECT_EQ(path.str(), t.pointer);
+    }
+    EXPECT_EQ(to_json(*find_pointer(doc, "")), to_json(doc));
+    EXPECT_EQ(JsonPath::pointer("/m~01").str(), "/m~01");
+    EXPECT_EQ(JsonPath::pointer("/m~01").size(), 1u);
+
+    for (std::string malformed: {"foo", "/a~", "/a~2", "/~/"})
+        EXPECT_THROW(JsonPath::pointer(malformed), std::invalid_argument) << malformed;
+    EXPECT_THROW(JsonPath::pointer("/bar").at(doc), std::out_of_range);
+}
+
+TEST(PathTests, Dotted)
+{
+    const JsonValue doc = parse(R"({"a": {"b": [10, {"c": "x"}], "0": "zero"}, "d": [[1, 2], [3]]})");
+    struct Test {
+        std::string path;
+        std::string result;
+    }
+    tests[]{
+        {"", to_json(doc)},
+        {"a.b", "[10,{\"c\":\"x\"}]"},
+        {"a.b[1].c", R"("x")"},
+        {"a.b.1.c", R"("x")"},
+        {"a.0", R"("zero")"},
+        {"d[0][1]", "2"},
+        {"d.1.0", "3"},
+        {"d[1][1]", "missing"},
+        {"a.c", "missing"},
+    };
+    for (const auto& t: tests)
+        EXPECT_EQ(lookup(JsonPath::dotted(t.path), doc), t.result) << t.path;
+    EXPECT_EQ(JsonPath::dotted("a.b[1].c").str(), "/a/b/1/c");
+
+    for (std::string malformed: {".a", "a.", "a..b", "a[", "a[x]", "a[01]", "a]", "a[0]b"})
+        EXPECT_THROW(JsonPath::dotted(malformed), std::invalid_argument) << malformed;
+}
+
+TEST(PathTests, Reuse)
+{
+    // the same path over documents of the same shape and of other shapes
+    const JsonPath path = JsonPath::dotted("user.id");
+    const std::string inputs[]{
+        R"({"text": "a", "user": {"name": "x", "id": 1}})",
+        R"({"text": "b", "user": {"name": "y", "id": 2}})",
+        R"({"user": {"id": 3}, "text": "c"})",
+        R"({"text": "d", "user": {"name": "z", "id": 4}})",
+        R"({"text": "e", "user": [1, 2]})",
+        R"({"text": "f", "user": {"name": "z", "id": 6}})",
+    };
+    const std::string results[]{"1", "2", "3", "4", "missing", "6"};
+    for (size_t i = 0; i < std::size(inputs); ++i)
+        EXPECT_EQ(lookup(path, parse(inputs[i])), results[i]) << inputs[i];
+
+    // objects past the hash threshold, and copies of the path
+    std::string large = "{";
+    for (int i = 0; i < 100; ++i)
+        large += (i ? ",\"k" : "\"k") + std::to_string(i) + "\":" + std::to_string(i);
+    large += "}";
+    const JsonValue doc = parse(large);
+    JsonPath copy = path;
+    for (int i: {99, 17, 0, 99}) {
+        JsonPath key = JsonPath::pointer("/k" + std::to_string(i));
+        EXPECT_EQ(lookup(key, doc), std::to_string(i));
+        copy = key;
+        EXPECT_EQ(lookup(copy, doc), std::to_string(i));
+    }
+    JsonValue mutable_doc = parse(large);
+    *JsonPath::pointer("/k5").find(mutable_doc) = int64_t{-5};
+    EXPECT_EQ(lookup(JsonPath::pointer("/k5"), mutable_doc), "-5");
+}
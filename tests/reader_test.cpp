@@ -0,0 +1,161 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <libacpp-json/reader.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+using Kind = JsonReader::Kind;
+
+std::string str(const JsonReader::Token& t) {
+    switch (t.kind) {
+        case Kind::object_begin: return "{";
+        case Kind::object_end: return "}";
+        case Kind::array_begin: return "[";
+        case Kind::array_end: return "]";
+        case Kind::key: return "k(" + std::string(t.text) + ")";
+        case Kind::string: return "s(" + std::string(t.text) + ")";
+        case Kind::number: return "n(" + std::string(t.text) + ")";
+        case Kind::boolean: return t.boolean ? "T" : "F";
+        case Kind::null: return "N";
+        case Kind::need_input: return "?";
+        case Kind::end: return "$";
+        case Kind::error: return "!";
+    }
+    return "";
+}
+
+// The tokens of input fed chunk bytes at a time, up to end or error. Each
+// chunk is overwritten once the reader asks for the next one, as a read
+// buffer would be. skip() is called after the keys in skip_keys, and after
+// the containers whose begin is the n-th token for n in skip_at.
+std::string read(const std::string& input, size_t chunk, const std::vector<std::string>& skip_keys = {},
+        const std::vector<size_t> skip_at = {}) {
+    JsonReader reader;
+    std::string tokens;
+    std::string buffer;
+    size_t pos = 0;
+    size_t n = 0;
+    while (true) {
+        const JsonReader::Token t = reader.next();
+        if (t.kind == Kind::need_input) {
+            std::fill(buffer.begin(), buffer.end(), '#');
+            if (pos == input.size()) {
+                reader.finish();
+            } else {
+                buffer = input.substr(pos, chunk);
+                pos += buffer.size();
+                reader.feed(buffer);
+            }
+            continue;
+        }
+        tokens += str(t);
+        if (t.kind == Kind::end || t.kind == Kind::error)
+            return tokens;
+        if (t.kind == Kind::key && std::find(skip_keys.begin(), skip_keys.end(), t.text) != skip_keys.end())
+            reader.skip();
+        if (std::find(skip_at.begin(), skip_at.end(), n) != skip_at.end())
+            reader.skip();
+        ++n;
+    }
+}
+
+} // namespace
+
+
+TEST(ReaderTests, Tokens)
+{
+    struct Test {
+        std::string input;
+        std::string tokens;
+    }
+    tests[]{
+        {R"( {"a":[1,-2.5e3,"x\"y\u0041",true,false,null],"b":{},"c":[]} )",
+            "{k(a)[n(1)n(-2.5e3)s(x\"yA)TFN]k(b){}k(c)[]}$"},
+        {"12", "n(12)$"},
+        {" \"s\" ", "s(s)$"},
+        {"[[[]],{\"k\":{\"k\":null}}]", "[[[]]{k(k){k(k)N}}]$"},
+        {"[1,}", "[n(1)!"},
+        {"{\"a\" 1}", "{k(a)!"},
+        {"[1 2]", "[n(1)!"},
+        {"{\"a\":1,}", "{k(a)n(1)!"},
+        {"[1] x", "[n(1)]!"},
+        {"[1", "[n(1)!"},
+        {"tru", "!"},
+        {"", "!"},
+        {"{1:2}", "{!"},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {1, 2, 3, 7, 100}) {
+            SCOPED_TRACE(t.input + " chunk " + std::to_string(chunk));
+            EXPECT_EQ(read(t.input, chunk), t.tokens);
+        }
+    }
+
+    JsonReader reader;
+    reader.feed("[18446744073709551615,-3,0.5]");
+    EXPECT_EQ(reader.next().kind, Kind::array_begin);
+    EXPECT_EQ(std::get<uint64_t>(reader.next().number), 18446744073709551615u);
+    EXPECT_EQ(std::get<int64_t>(reader.next().number), -3);
+    EXPECT_EQ(std::get<double>(reader.next().number), 0.5);
+    EXPECT_EQ(reader.next().kind, Kind::array_end);
+    EXPECT_EQ(reader.next().kind, Kind::need_input);
+    reader.finish();
+    EXPECT_EQ(reader.next().kind, Kind::end);
+
+    // max_depth
+    JsonReader shallow(2);
+    shallow.feed("[[[1]]]");
+    EXPECT_EQ(shallow.next().kind, Kind::array_begin);
+    EXPECT_EQ(shallow.next().kind, Kind::array_begin);
+    EXPECT_EQ(shallow.next().kind, Kind::error);
+    EXPECT_EQ(shallow.next().kind, Kind::error);
+    shallow.reset();
+    shallow.feed("[[1]]");
+    shallow.finish();
+    EXPECT_EQ(shallow.next().kind, Kind::array_begin);
+    EXPECT_EQ(shallow.next().kind, Kind::array_begin);
+    EXPECT_EQ(str(shallow.next()), "n(1)");
+}
+
+TEST(ReaderTests, Skip)
+{
+    const std::string input = R"({"a":{"x":[1,{"y":"}]\"\\"}]},"id":7,"b":[1,2,3],"s":"q\"}[","n":-1.5,)"
+        R"("t":true,"c":{"d":[{}]},"e":"f"})";
+    struct Test {
+        std::vector<std::string> keys;
+        std::vector<size_t> at;
+        std::string tokens;
+    }
+    tests[]{
+        {{"a", "b", "s", "n", "t", "c"}, {}, "{k(a)k(id)n(7)k(b)k(s)k(n)k(t)k(c)k(e)s(f)}$"},
+        {{"e"}, {}, "{k(a){k(x)[n(1){k(y)s(}]\"\\)}]}k(id)n(7)k(b)[n(1)n(2)n(3)]k(s)s(q\"}[)k(n)n(-1.5)"
+            "k(t)Tk(c){k(d)[{}]}k(e)}$"},
+        // the rest of the object of "a" after its begin, then of the array
+        // of "b" after its first element, then of the whole document
+        {{}, {2, 7, 9}, "{k(a){k(id)n(7)k(b)[n(1)k(s)s(q\"}[)$"},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {1, 2, 5, 1000}) {
+            SCOPED_TRACE("chunk " + std::to_string(chunk));
+            EXPECT_EQ(read(input, chunk, t.keys, t.at), t.tokens);
+        }
+    }
+
+    // a skipped number at the end of the input, and skip() at the top level
+    EXPECT_EQ(read("{\"a\":12", 3, {"a"}), "{k(a)!");
+    EXPECT_EQ(read("[1,2", 1, {}, {0}), "[!");
+    EXPECT_EQ(read("7", 1, {}, {0}), "n(7)$");
+}
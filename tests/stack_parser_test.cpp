@@ -0,0 +1,134 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include "libacpp-json/log.h"
+
+#include <libacpp-json/parser.h>
+#include <libacpp-json/stack_parser.h>
+
+#include "event_consumer.h"
+
+using namespace libacpp::json;
+using libacpp::json::test::EventConsumer;
+using libacpp::json::test::parse_chunked;
+
+
+TEST(StackParserTests, SameEventsAsValueParser)
+{
+    std::string inputs[]{
+        "null",
+        "true ",
+        "false",
+        R"("abc\nA")",
+        "[]",
+        "{}",
+        "[ ]",
+        "{ }",
+        "[1]",
+        "[1,2]",
+        "[-12.5e+3 , 7 ]",
+        R"([{"a":1}])",
+        R"({"a":{"b":1},"c":2})",
+        R"([[1,2],[3],[]])",
+        R"({"a":[1,{"x":2}],"b":{}})",
+        R"({ "key1" : [null, 123.45e-67, true, false, "abc"], "key2" : { "key3" : "abcd", "key4" : { } } })",
+        "[[[[[[[[[[\"deep\"]]]]]]]]]]",
+    };
+    for (const auto& input: inputs) {
+        for (size_t chunk: {0, 1, 2, 3, 7}) {
+            EventConsumer expected;
+            ValueParser<EventConsumer> vp{expected};
+            auto r1 = parse_chunked(vp, input, chunk);
+
+            EventConsumer actual;
+            StackParser<EventConsumer> sp{actual};
+            auto r2 = parse_chunked(sp, input, chunk);
+
+            EXPECT_EQ(r1, ParseResult::ok) << input << " chunk: " << chunk;
+            EXPECT_EQ(r2, ParseResult::ok) << input << " chunk: " << chunk;
+            EXPECT_EQ(actual.events(), expected.events()) << input << " chunk: " << chunk;
+            EXPECT_EQ(sp.depth(), 0) << input;
+        }
+    }
+
+    // the same input is rejected by both, after the same events
+    std::string malformed[]{
+        "[1,]",
+        R"({"a":1,})",
+        "[1, ]",
+        R"({"a":[true,], "b":2})",
+    };
+    for (const auto& input: malformed) {
+        for (size_t chunk: {0, 1, 2, 3, 7}) {
+            EventConsumer expected;
+            ValueParser<EventConsumer> vp{expected};
+            EXPECT_EQ(parse_chunked(vp, input, chunk), ParseResult::error) << input << " chunk: " << chunk;
+
+            EventConsumer actual;
+            StackParser<EventConsumer> sp{actual};
+            EXPECT_EQ(parse_chunked(sp, input, chunk), ParseResult::error) << input << " chunk: " << chunk;
+            EXPECT_EQ(actual.events(), expected.events()) << input << " chunk: " << chunk;
+        }
+    }
+}
+
+
+TEST(StackParserTests, Errors)
+{
+    struct Test {
+        std::string input;
+        ParseResult parseResult;
+    }
+    tests[]{
+        {"{null}", ParseResult::error},
+        {"[1 2]", ParseResult::error},
+        {"[1,]", ParseResult::error},
+        {R"({"a" 1})", ParseResult::error},
+        {R"({"a":1,})", ParseResult::error},
+        {R"({"a":1])", ParseResult::error},
+        {"x", ParseResult::error},
+        {"nUll", ParseResult::error},
+        {"[", ParseResult::partial},
+        {R"({"a":)", ParseResult::partial},
+        {R"({"a":"b)", ParseResult::partial},
+    };
+    for (const auto& t: tests) {
+        for (size_t chunk: {0, 1}) {
+            EventConsumer consumer;
+            StackParser<EventConsumer> sp{consumer};
+            EXPECT_EQ(parse_chunked(sp, t.input, chunk), t.parseResult) << t.input << " chunk: " << chunk;
+        }
+    }
+}
+
+
+TEST(StackParserTests, Depth)
+{
+    std::string deep = std::string(40, '[') + "1" + std::string(40, ']');
+
+    EventConsumer consumer;
+    StackParser<EventConsumer> sp{consumer, 64};
+    const char* p = deep.data();
+    const char* middle = p + 41;
+    EXPECT_EQ(sp.parse(p, middle), ParseResult::partial);
+    EXPECT_EQ(sp.depth(), 40);
+    EXPECT_EQ(sp.parse(p, deep.data() + deep.size()), ParseResult::ok);
+    EXPECT_EQ(sp.depth(), 0);
+
+    EventConsumer limited;
+    StackParser<EventConsumer> shallow{limited, 39};
+    p = deep.data();
+    EXPECT_EQ(shallow.parse(p, deep.data() + deep.size()), ParseResult::error);
+
+    // reset() makes the parser reusable for the next document
+    shallow.reset();
+    std::string doc = "[[1]]";
+    p = doc.data();
+    EXPECT_EQ(shallow.parse(p, doc.data() + doc.size()), ParseResult::ok);
+    EXPECT_EQ(limited.events().substr(limited.events().size() - 8), "[[n(1)]]");
+}
@@ -0,0 +1,180 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/indexed_parser.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/tape.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+std::string text(JsonValue value) {
+    std::stringstream ss;
+    to_string(value, ss);
+    return ss.str();
+}
+
+// the document as JsonConsumer builds it
+std::string dom_text(const std::string& input) {
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    EXPECT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << input;
+    return text(consumer.root());
+}
+
+} // namespace
+
+
+TEST(TapeTests, Parse)
+{
+    std::string tests[]{
+        "null",
+        "true",
+        "-17",
+        "18446744073709551615",
+        "3.25",
+        R"("short")",
+        R"("a string longer than six bytes")",
+        R"("esc\"d")",
+        R"("a long escaped string: tab\tand \"quote\" é")",
+        "[]",
+        "{}",
+        R"([1,"two",[3,[4]],{"five":5},null,false])",
+        R"({"k1":"v1","a long key":{"nested":[true,{"x":-1.5}]},"":"","k\nl":"é"})",
+    };
+    for (const auto& t: tests) {
+        // a top level number only ends at the byte after it
+        const std::string input = t + " ";
+        const std::string expected = dom_text(input);
+        // sync
+        {
+            Tape tape;
+            TapeConsumer consumer(tape);
+            ValueParser<TapeConsumer> vp(consumer);
+            const char* p = input.data();
+            ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << input;
+            EXPECT_EQ(text(to_json_value(tape.root())), expected) << input;
+        }
+        // byte by byte: strings cut by a chunk arrive char by char
+        {
+            Tape tape;
+            TapeConsumer consumer(tape);
+            ValueParser<TapeConsumer> vp(consumer);
+            ParseResult r = ParseResult::partial;
+            for (char c: input) {
+                const char* p = &c;
+                r = vp.parse(p, p + 1);
+                if (r != ParseResult::partial)
+                    break;
+            }
+            ASSERT_EQ(r, ParseResult::ok) << input;
+            EXPECT_EQ(text(to_json_value(tape.root())), expected) << input;
+        }
+        // indexed
+        {
+            Tape tape;
+            TapeConsumer consumer(tape);
+            IndexedParser<TapeConsumer> ip(consumer);
+            ASSERT_EQ(ip.parse(input.data(), input.data() + input.size()), ParseResult::ok) << input;
+            EXPECT_EQ(text(to_json_value(tape.root())), expected) << input;
+        }
+    }
+}
+
+TEST(TapeTests, Navigation)
+{
+    const std::string input = R"({"id":12345,"name":"a name long enough","tags":["x","y",[1,2,3]],)"
+        R"("big":18446744073709551615,"neg":-9007199254740993,"pi":3.25,"ok":true,"none":null})";
+    Tape tape;
+    TapeConsumer consumer(tape);
+    ValueParser<TapeConsumer> vp(consumer);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+
+    TapeRef root = tape.root();
+    ASSERT_TRUE(root.is_object());
+    EXPECT_EQ(root.size(), 8u);
+    EXPECT_EQ(root.end_index(), tape.words().size());
+
+    EXPECT_EQ(root.find("id")->get_int64(), 12345);
+    EXPECT_EQ(root.find("name")->get_string(), "a name long enough");
+    EXPECT_EQ(root.find("big")->type(), TapeType::uint64);
+    EXPECT_EQ(root.find("big")->get_uint64(), 18446744073709551615u);
+    EXPECT_EQ(root.find("neg")->get_int64(), -9007199254740993);
+    EXPECT_EQ(root.find("pi")->get_double(), 3.25);
+    EXPECT_TRUE(root.find("ok")->get_bool());
+    EXPECT_TRUE(root.find("none")->is_null());
+    EXPECT_FALSE(root.find("missing"));
+    EXPECT_FALSE(root.at(0));
+
+    TapeRef tags = *root.find("tags");
+    ASSERT_TRUE(tags.is_array());
+    EXPECT_EQ(tags.size(), 3u);
+    EXPECT_EQ(tags.at(0)->type(), TapeType::short_string);
+    EXPECT_EQ(tags.at(1)->get_string(), "y");
+    EXPECT_EQ(tags.at(2)->size(), 3u);
+    EXPECT_EQ(tags.at(2)->at(2)->get_int64(), 3);
+    EXPECT_FALSE(tags.at(3));
+    // skipping the nested array lands on the next member's key
+    EXPECT_EQ(TapeRef(tape, tags.end_index()).get_string(), "big");
+
+    std::vector<std::string> keys;
+    for (auto member: root.members())
+        keys.emplace_back(member.key);
+    EXPECT_EQ(keys, (std::vector<std::string>{"id", "name", "tags", "big", "neg", "pi", "ok", "none"}));
+
+    // reset() makes room for the next document
+    consumer.reset();
+    const std::string next = "[7]";
+    ValueParser<TapeConsumer> vp2(consumer);
+    p = next.data();
+    ASSERT_EQ(vp2.parse(p, p + next.size()), ParseResult::ok);
+    EXPECT_EQ(tape.words().size(), 4u);
+    EXPECT_EQ(tape.root().at(0)->get_int64(), 7);
+}
+
+TEST(TapeTests, DuplicateKeys)
+{
+    // the last value wins, as in the JsonConsumer tree
+    const std::string input = R"({"k":1,"x":[2],"k":{"k":3,"k":"last"}})";
+    Tape tape;
+    TapeConsumer consumer(tape);
+    ValueParser<TapeConsumer> vp(consumer);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+    EXPECT_FALSE(consumer.failed());
+
+    TapeRef root = tape.root();
+    EXPECT_EQ(root.size(), 3u);
+    ASSERT_TRUE(root.find("k")->is_object());
+    EXPECT_EQ(root.find("k")->find("k")->get_string(), "last");
+    EXPECT_EQ(text(to_json_value(root)), dom_text(input));
+    EXPECT_EQ(text(to_json_value(root)), R"({"k":{"k":"last"},"x":[2]})");
+}
+
+TEST(TapeTests, FromJsonValue)
+{
+    const std::string input = R"({"a":[1,-2.5,"x",true,null,{}],"a much longer key":{"k":"a long string value"}})";
+    JsonConsumer consumer;
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok);
+
+    Tape tape;
+    to_tape(consumer.root(), tape);
+    EXPECT_EQ(text(to_json_value(tape.root())), text(consumer.root()));
+    EXPECT_EQ(tape.root().size(), 2u);
+    EXPECT_EQ(tape.root().find("a")->at(1)->get_double(), -2.5);
+}
@@ -0,0 +1,119 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+// The parsers here are instantiated only for the consumer of this file, so
+// they can be traced whatever the ACPPJSON_TRACE option of the build.
+#ifndef ACPPJSON_TRACE
+    #define ACPPJSON_TRACE
+#endif
+
+#include <gtest/gtest.h>
+
+#include <libacpp-json/indexed_parser.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/stack_parser.h>
+
+#include "event_consumer.h"
+
+using namespace libacpp::json;
+using libacpp::json::test::parse_chunked;
+
+namespace {
+
+struct TracedConsumer: test::EventConsumer {
+    typedef TracedConsumer KeyConsumerType;
+    typedef TracedConsumer ValueConsumerType;
+    typedef TracedConsumer KeyValueConsumerType;
+    typedef TracedConsumer NumberConsumerType;
+    typedef TracedConsumer StringConsumerType;
+    typedef TracedConsumer ObjectConsumerType;
+    typedef TracedConsumer ArrayConsumerType;
+    KeyConsumerType& key_consumer() { return *this;}
+    ValueConsumerType& value_consumer() { return *this;}
+    NumberConsumerType& number_consumer() { return *this;}
+    StringConsumerType& string_consumer() { return *this;}
+    ObjectConsumerType& object_consumer() { return *this;}
+    ArrayConsumerType& array_consumer() { return *this;}
+};
+
+const trace::Counters& counters() { return trace::recorder().counters(); }
+
+} // namespace
+
+
+TEST(TraceTests, Counters)
+{
+    const std::string input = R"({"a":[1,[2,"x\ny"]],"b\"\u0041":{}})";
+
+    for (size_t chunk: {0, 1, 3}) {
+        SCOPED_TRACE(chunk);
+        trace::recorder().reset();
+        TracedConsumer consumer;
+        ValueParser<TracedConsumer> parser(consumer);
+        EXPECT_EQ(parse_chunked(parser, input, chunk), ParseResult::ok);
+
+        EXPECT_EQ(counters().bytes, input.size());
+        EXPECT_EQ(counters().escapes, 3u);
+        EXPECT_EQ(counters().containers, 4u);
+        EXPECT_EQ(counters().depth, 0u);
+        EXPECT_EQ(counters().max_depth, 3u);
+        EXPECT_EQ(counters().errors, 0u);
+        // one call per chunk, the last one completing the value
+        const size_t calls = chunk == 0 ? 1 : (input.size() + chunk - 1) / chunk;
+        EXPECT_EQ(counters().calls, calls);
+        EXPECT_EQ(counters().partials, calls - 1);
+        EXPECT_EQ(trace::recorder().history().back().event, trace::Event::ok);
+    }
+
+    trace::recorder().reset();
+    TracedConsumer stack_consumer;
+    StackParser<TracedConsumer> stack_parser(stack_consumer);
+    EXPECT_EQ(parse_chunked(stack_parser, input, 2), ParseResult::ok);
+    EXPECT_EQ(counters().bytes, input.size());
+    EXPECT_EQ(counters().escapes, 3u);
+    EXPECT_EQ(counters().max_depth, 3u);
+
+    trace::recorder().reset();
+    TracedConsumer indexed_consumer;
+    IndexedParser<TracedConsumer> indexed_parser(indexed_consumer);
+    EXPECT_EQ(indexed_parser.parse(input.data(), input.data() + input.size()), ParseResult::ok);
+    EXPECT_EQ(counters().calls, 1u);
+    EXPECT_EQ(counters().bytes, input.size());
+    EXPECT_EQ(counters().escapes, 3u);
+    EXPECT_EQ(counters().max_depth, 3u);
+}
+
+TEST(TraceTests, History)
+{
+    trace::recorder().reset();
+    TracedConsumer consumer;
+    ValueParser<TracedConsumer> parser(consumer);
+    const std::string input = "[[1,}";
+    EXPECT_EQ(parse_chunked(parser, input, 0), ParseResult::error);
+
+    EXPECT_EQ(counters().errors, 1u);
+    EXPECT_EQ(counters().depth, 0u);
+    EXPECT_EQ(counters().max_depth, 2u);
+    std::vector<trace::Record> history = trace::recorder().history();
+    ASSERT_EQ(history.size(), 3u);
+    EXPECT_EQ(history[0].event, trace::Event::container_begin);
+    EXPECT_EQ(history[1].event, trace::Event::container_begin);
+    EXPECT_EQ(history[1].value, 2u);
+    EXPECT_EQ(history[2].event, trace::Event::error);
+    EXPECT_EQ(history[2].value, 4u);
+
+    // the ring keeps the last events only
+    trace::recorder().reset();
+    ValueParser<TracedConsumer> deep_parser(consumer);
+    const std::string deep = std::string(100, '[') + std::string(100, ']');
+    EXPECT_EQ(parse_chunked(deep_parser, deep, 0), ParseResult::ok);
+    history = trace::recorder().history();
+    ASSERT_EQ(history.size(), trace::Recorder::history_size);
+    EXPECT_EQ(history.back().event, trace::Event::ok);
+    EXPECT_EQ(history.back().value, deep.size());
+    EXPECT_EQ(history.front().event, trace::Event::container_end);
+    EXPECT_EQ(counters().max_depth, 100u);
+}
@@ -0,0 +1,251 @@
+//  Copyright Marcos Cambón-López 2024-2025.
+
+// Distributed under the Mozilla Public License Version 2.0.
+//    (See accompanying file LICENSE or copy at
+//          https://www.mozilla.org/en-US/MPL/2.0/)
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include <libacpp-json/consumer.h>
+#include <libacpp-json/indexed_parser.h>
+#include <libacpp-json/parser.h>
+#include <libacpp-json/writer.h>
+
+using namespace libacpp::json;
+
+namespace {
+
+JsonValue parse(const std::string& input, bool lazy_numbers = false) {
+    JsonConsumer consumer;
+    consumer.set_lazy_numbers(lazy_numbers);
+    ValueParser<JsonConsumer> vp(consumer);
+    const char* p = input.data();
+    EXPECT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << input;
+    return std::move(consumer.root());
+}
+
+} // namespace
+
+
+TEST(WriterTests, String)
+{
+    const std::string long_plain(70, 'x');
+    struct Test {
+        std::string input;
+        std::string result;
+    }
+    tests[]{
+        {"", R"("")"},
+        {"abc", R"("abc")"},
+        {"a\"b", R"("a\"b")"},
+        {"a\\b", R"("a\\b")"},
+        {"\b\f\n\r\t", R"("\b\f\n\r\t")"},
+        {std::string("\x00\x01\x1f", 3), R"("\u0000\u0001\u001f")"},
+        {"caf\xc3\xa9 \x7f", "\"caf\xc3\xa9 \x7f\""},
+        // runs longer than the SIMD blocks, with escapes at their edges
+        {long_plain, "\"" + long_plain + "\""},
+        {long_plain + "\"" + long_plain, "\"" + long_plain + "\\\"" + long_plain + "\""},
+        {std::string(31, 'a') + "\n" + std::string(32, 'b') + "\t", "\"" + std::string(31, 'a') + "\\n"
+            + std::string(32, 'b') + "\\t\""},
+    };
+    WriteBuffer out;
+    for (const auto& t: tests) {
+        out.clear();
+        write::string(out, t.input);
+        EXPECT_EQ(out.view(), t.result);
+        // and reads back
+        JsonValue v = parse(t.result);
+        EXPECT_EQ(std::string_view(std::get<JsonString>(v)), t.input);
+    }
+}
+
+TEST(WriterTests, Number)
+{
+    struct Test {
+        double input;
+        std::string result;
+    }
+    tests[]{
+        {0.0, "0.0"},
+        {-0.0, "-0.0"},
+        {3.25, "3.25"},
+        {0.1, "0.1"},
+        {100.0, "100.0"},
+        {-1.5e-3, "-0.0015"},
+        {1e22, "1e+22"},
+        {5e-324, "5e-324"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"},
+        {std::numeric_limits<double>::infinity(), "null"},
+        {std::numeric_limits<double>::quiet_NaN(), "null"},
+    };
+    WriteBuffer out;
+    for (const auto& t: tests) {
+        out.clear();
+        write::number(out, t.input);
+        EXPECT_EQ(out.view(), t.result);
+        if (std::isfinite(t.input)) {
+            EXPECT_EQ(std::get<double>(parse(out.str() + " ")), t.input) << t.result;
+        }
+    }
+    out.clear();
+    write::number(out, std::numeric_limits<int64_t>::min());
+    out.push_back(',');
+    write::number(out, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(out.view(), "-9223372036854775808,18446744073709551615");
+}
+
+TEST(WriterTests, Document)
+{
+    const std::string input = R"({"a":[1,-2.5,"x\ty",true,null,{},[]],"b":{"c":18446744073709551615},"d":[[]]})";
+    JsonValue value = parse(input);
+    EXPECT_EQ(to_json(value), input);
+    EXPECT_EQ(to_json(value, JsonFormat::pretty),
+R"({
+  "a": [
+    1,
+    -2.5,
+    "x\ty",
+    true,
+    null,
+    {},
+    []
+  ],
+  "b": {
+    "c": 18446744073709551615
+  },
+  "d": [
+    []
+  ]
+})");
+    // the pretty form reads back to the same document
+    EXPECT_EQ(to_json(parse(to_json(value, JsonFormat::pretty))), input);
+}
+
+TEST(WriterTests, Flush)
+{
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    std::string expected;
+    {
+        WriteBuffer out(fileno(file), 16);
+        for (int i = 0; i < 100; ++i) {
+            write::string(out, "item " + std::to_string(i));
+            expected += "\"item " + std::to_string(i) + "\"";
+            // never much more than the flush size in memory
+            EXPECT_LE(out.size(), 16u);
+        }
+        EXPECT_TRUE(out.flush());
+        EXPECT_EQ(out.size(), 0u);
+    }
+    std::rewind(file);
+    std::string written(expected.size() + 1, '\0');
+    written.resize(std::fread(written.data(), 1, written.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(written, expected);
+}
+
+TEST(WriterTests, Pipe)
+{
+    struct Test {
+        std::string input;
+        std::string result;
+    }
+    tests[]{
+        {"null", "null"},
+        {"[ ] ", "[]"},
+        {R"({ "a" : [ 1 , -2.5 , "x\ty" , true , null , { } ] , "b\"c" : { "d" : 1.50E+2 } } )",
+            R"({"a":[1,-2.5,"x\ty",true,null,{}],"b\"c":{"d":1.50E+2}})"},
+        {R"([[[["deep"]]],{"k":[{"k":{}}]}])", R"([[[["deep"]]],{"k":[{"k":{}}]}])"},
+    };
+    for (const auto& t: tests) {
+        // a top level number only ends at the byte after it
+        const std::string input = t.input + " ";
+        WriteBuffer out;
+        {
+            JsonWriter writer(out);
+            ValueParser<JsonWriter> vp(writer);
+            const char* p = input.data();
+            ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << t.input;
+            EXPECT_EQ(out.view(), t.result);
+            EXPECT_EQ(writer.depth(), 0u);
+        }
+        // cut anywhere, strings and numbers arrive in pieces
+        out.clear();
+        {
+            JsonWriter writer(out);
+            ValueParser<JsonWriter> vp(writer);
+            ParseResult r = ParseResult::partial;
+            for (size_t i = 0; i < input.size() && r == ParseResult::partial; ++i) {
+                const char* p = input.data() + i;
+                r = vp.parse(p, p + 1);
+            }
+            ASSERT_EQ(r, ParseResult::ok) << t.input;
+            EXPECT_EQ(out.view(), t.result);
+        }
+        out.clear();
+        {
+            JsonWriter writer(out);
+            IndexedParser<JsonWriter> ip(writer);
+            ASSERT_EQ(ip.parse(input.data(), input.data() + input.size()), ParseResult::ok) << t.input;
+            EXPECT_EQ(out.view(), t.result);
+        }
+        // pretty printing the stream is pretty printing the document
+        out.clear();
+        {
+            JsonWriter writer(out, JsonFormat::pretty);
+            ValueParser<JsonWriter> vp(writer);
+            const char* p = input.data();
+            ASSERT_EQ(vp.parse(p, p + input.size()), ParseResult::ok) << t.input;
+            EXPECT_EQ(out.view(), to_json(parse(t.result + " ", true), JsonFormat::pretty));
+        }
+    }
+
+    // whole strings keep their escapes; strings cut by a chunk are decoded
+    // and escaped again
+    const std::string input = R"(["é\/"])";
+    WriteBuffer out;
+    JsonWriter writer(out);
+    ValueParser<JsonWriter> vp(writer);
+    const char* p = input.data();
+    ASSERT_EQ(vp.parse(p, p + 3), ParseResult::partial);
+    ASSERT_EQ(vp.parse(p, input.data() + input.size()), ParseResult::ok);
+    EXPECT_EQ(out.view(), "[\"\xc3\xa9/\"]");
+}
+
+TEST(WriterTests, Events)
+{
+    WriteBuffer out;
+    JsonWriter writer(out, JsonFormat::pretty);
+    writer.object_begin();
+    writer.key("id");
+    writer.number(int64_t{-7});
+    writer.key("tags");
+    writer.array_begin();
+    writer.string("a\"b");
+    writer.number(0.5);
+    writer.boolean(false);
+    writer.null();
+    writer.array_end();
+    writer.key("empty");
+    writer.object_begin();
+    writer.object_end();
+    EXPECT_EQ(writer.depth(), 1u);
+    writer.object_end();
+    EXPECT_EQ(writer.depth(), 0u);
+    EXPECT_EQ(out.view(),
+R"({
+  "id": -7,
+  "tags": [
+    "a\"b",
+    0.5,
+    false,
+    null
+  ],
+  "empty": {}
+})");
+}